@@ -0,0 +1,159 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "analysis.h"
+#include "table.h"
+#include <cmath>
+#include <numbers>
+
+namespace dsp {
+
+      analysis::analysis() noexcept:
+      analysis(stft_frame_size)
+{
+}
+
+      analysis::analysis(int size) noexcept:
+      core(o_none),
+      m_input(this),
+      m_fft(size),
+      m_hop(0),
+      m_position(0),
+      m_window(nullptr)
+{
+      set_sample_format(fmt_apm);
+      set_input_format(fmt_pcm_1);
+      if(m_fft.is_valid()) {
+          int  l_bins = m_fft.get_bin_count();
+          auto l_window = reinterpret_cast<const fptype*>(tbl_acquire(tbl_window, size, size * sizeof(fptype), stft_build_window));
+          auto l_data = reinterpret_cast<fptype*>(malloc((size * 2 + l_bins * 4) * sizeof(fptype)));
+          if((l_window != nullptr) &&
+              (l_data != nullptr)) {
+              m_hop = size / 2;
+              m_window = l_window;
+              m_history = l_data;
+              m_frame = m_history + size;
+              m_spectrum = m_frame + size;
+              m_bins_re = m_spectrum + l_bins * 2;
+              m_bins_im = m_bins_re + l_bins;
+              pcm_clr(m_history, size);
+              pcm_clr(m_spectrum, l_bins * 2);
+          } else
+          if(true) {
+              tbl_release(l_window);
+              free(l_data);
+          }
+      }
+}
+
+      analysis::~analysis()
+{
+      if(m_window != nullptr) {
+          tbl_release(m_window);
+          free(m_history);
+      }
+}
+
+/* stft_build_window()
+   table store generator for the square root Hann window shared by the stft nodes; the key is the window size
+*/
+bool  stft_build_window(void* data, std::size_t, const void* key, void*) noexcept
+{
+      int   l_size = *reinterpret_cast<const int*>(key);
+      auto  p_window = reinterpret_cast<fptype*>(data);
+      for(int i_index = 0; i_index < l_size; i_index++) {
+          p_window[i_index] = std::sqrt(0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * i_index / l_size));
+      }
+      return true;
+}
+
+/* dsp_analyse()
+   transform the input history and shift it by a hop; all `size / 2 + 1` bins are kept, with the DC slot then taking over
+   the Nyquist bin as well (see analysis)
+*/
+void  analysis::dsp_analyse() noexcept
+{
+      int l_size = m_fft.get_size();
+      int l_bins = m_fft.get_bin_count();
+      for(int i_index = 0; i_index < l_size; i_index++) {
+          m_frame[i_index] = m_history[i_index] * m_window[i_index];
+      }
+      m_fft.forward(m_frame, m_bins_re, m_bins_im);
+      for(int i_bin = 0; i_bin < l_bins; i_bin++) {
+          m_spectrum[i_bin * 2] = std::hypot(m_bins_re[i_bin], m_bins_im[i_bin]);
+          m_spectrum[i_bin * 2 + 1] = std::atan2(m_bins_im[i_bin], m_bins_re[i_bin]);
+      }
+      m_spectrum[0] = std::hypot(m_bins_re[0], m_bins_re[m_hop]);
+      m_spectrum[1] = std::atan2(m_bins_re[m_hop], m_bins_re[0]);
+      pcm_mov(m_history, m_history + m_hop, l_size - m_hop);
+}
+
+bool  analysis::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      fptype* l_input_ptr = m_input.get_return_vector();
+      fptype* l_output_ptr = dsp_get_return_vector();
+      fptype* l_history_ptr = m_history + m_hop;
+      if(m_window == nullptr) {
+          return false;
+      }
+      for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+          if(op & op_render_additive) {
+              l_output_ptr[i_frame * 2] += m_spectrum[m_position * 2];
+              l_output_ptr[i_frame * 2 + 1] += m_spectrum[m_position * 2 + 1];
+          } else
+          if(true) {
+              l_output_ptr[i_frame * 2] = m_spectrum[m_position * 2];
+              l_output_ptr[i_frame * 2 + 1] = m_spectrum[m_position * 2 + 1];
+          }
+          if(l_input_ptr != nullptr) {
+              l_history_ptr[m_position] = l_input_ptr[i_frame];
+          } else
+              l_history_ptr[m_position] = 0.0f;
+          if(++m_position == m_hop) {
+              dsp_analyse();
+              m_position = 0;
+          }
+      }
+      return true;
+}
+
+gate& analysis::get_input() noexcept
+{
+      return m_input;
+}
+
+int   analysis::get_frame_size() const noexcept
+{
+      return m_fft.get_size();
+}
+
+int   analysis::get_hop_size() const noexcept
+{
+      return m_hop;
+}
+
+bool  analysis::is_valid() const noexcept
+{
+      return m_window != nullptr;
+}
+
+/*namespace dsp*/ }
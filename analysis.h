@@ -0,0 +1,73 @@
+#ifndef dsp_analysis_h
+#define dsp_analysis_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include "fft.h"
+
+namespace dsp {
+
+/* analysis
+   short-time fourier transform: turns a mono PCM input into an amplitude/phase (`fmt_apm`) stream;
+   frames of `size` samples are taken every `size / 2` samples under a square root Hann window, and each frame spectrum is
+   emitted over the `size / 2` output frames that follow it, one (amplitude, phase) bin per frame, from DC up to but not
+   including Nyquist; the DC and Nyquist bins are both real, and share the first frame as the real and imaginary part of
+   a single value, such that all `size / 2 + 1` bins make it through
+*/
+class analysis: public core
+{
+  gate      m_input;
+  fft       m_fft;
+  int       m_hop;
+  int       m_position;
+  const fptype* m_window;
+  fptype*   m_history;        // last `size` input samples
+  fptype*   m_frame;
+  fptype*   m_bins_re;
+  fptype*   m_bins_im;
+  fptype*   m_spectrum;       // (amplitude, phase) pairs of all bins, the first `size / 2` of which are being emitted
+
+  protected:
+          void    dsp_analyse() noexcept;
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          analysis() noexcept;
+          analysis(int) noexcept;
+          analysis(const analysis&) noexcept = delete;
+          analysis(analysis&&) noexcept = delete;
+  virtual ~analysis();
+
+          gate&   get_input() noexcept;
+          int     get_frame_size() const noexcept;
+          int     get_hop_size() const noexcept;
+          bool    is_valid() const noexcept;
+
+          analysis& operator=(const analysis&) noexcept = delete;
+          analysis& operator=(analysis&&) noexcept = delete;
+};
+
+bool  stft_build_window(void*, std::size_t, const void*, void*) noexcept;
+
+/*namespace dsp*/ }
+#endif
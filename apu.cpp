@@ -21,6 +21,7 @@
 **/
 #include "apu.h"
 #include "core.h"
+#include "port.h"
 #include <limits>
 #include <numbers>
 
@@ -72,7 +73,17 @@ namespace dsp {
       m_process_head(nullptr),
       m_process_tail(nullptr),
       m_iteration_fingerprint(0u),
-      m_busy(false)
+      m_busy(false),
+      m_ahead_buffer(nullptr),
+      m_ahead_frames(0),
+      m_ahead_limit(0),
+      m_ahead_run(false),
+      m_ahead_idle(false),
+      m_ahead_wake(0u),
+      m_ahead_render_count(0u),
+      m_ahead_fault_count(0u),
+      m_ahead_stall_count(0u),
+      m_ahead_underrun_count(0u)
 {
       // attach_variable("time");
       // attach_variable("dt");
@@ -80,6 +91,7 @@ namespace dsp {
 
       apu::~apu()
 {
+      stop();
       dsp_dispose_process_list();
       dsg_clear();
       dvf_dispose(false);
@@ -730,7 +742,7 @@ fptype*  apu::dvf_get_data_immediate(int index) noexcept
       if(p_vector->r_size == v_size_auto) {
           // when size is zero compute the buffer size to `sample_rate * sample_size * dt
           l_size = get_round_value(
-              dsp_get_sample_count() * dsp_get_sample_size(),
+              dsp_get_vector_size(p_vector->r_format),
               memory_vector_block
           );
       } else
@@ -798,6 +810,7 @@ int   apu::dvf_acquire(int size, unsigned int flags) noexcept
           if(i_vector < m_dvf_size) {
               p_vector = dvf_get_ptr(i_vector);
               if(p_vector->s_used_bit == false) {
+                  p_vector->r_format = fmt_undef;
                   if(size == v_size_auto) {
                       p_vector->r_size = v_size_auto;
                   } else
@@ -825,6 +838,30 @@ int   apu::dvf_acquire(int size, unsigned int flags) noexcept
       return v_invalid;
 }
 
+/* dvf_bind()
+   bind the vector to a memory region that is not owned by the sample stores (typically a device or a ring buffer supplied
+   by the caller); the vector is marked as `far`, such that dvf_release() drops the reference instead of the memory
+*/
+bool  apu::dvf_bind(int index, fptype* address, int size) noexcept
+{
+      if(index != v_invalid) {
+          vector_t* p_vector = dvf_get_ptr(index);
+          if(p_vector->s_keep_bit) {
+              if(p_vector->data != nullptr) {
+                  dps_release(p_vector->data, p_vector->size);
+              }
+          }
+          p_vector->data = address;
+          p_vector->size = size;
+          p_vector->r_size = -1;
+          p_vector->r_keep = false;
+          p_vector->s_far_bit = true;
+          p_vector->s_keep_bit = false;
+          return true;
+      }
+      return false;
+}
+
 /* dvf_release()
 */
 void  apu::dvf_release(int index, bool force_persist_release) noexcept
@@ -905,6 +942,7 @@ apu::process_t*   apu::dsp_make_process(core* core_ptr) noexcept
           // initialize the new process
           p_process->sample_format = m_sample_format;
           p_process->sample_rate = m_sample_rate;
+          p_process->sample_factor = 0;
           p_process->return_flags = dc::e_okay;
           p_process->return_vector = dc::v_default;
           p_process->vector_assign_lb = 0;
@@ -961,11 +999,12 @@ void  apu::dsp_dispose_process_list() noexcept
       }
 }
 
-void  apu::dsp_push(process_base_t* process, branch_base_t&  branch, int return_vector) noexcept
+void  apu::dsp_push(process_base_t* process, branch_base_t&  branch, int return_vector, unsigned int sample_format, int sample_rate) noexcept
 {
       // set up the new branch
-      branch.sample_format = m_sample_format;
-      branch.sample_rate = m_sample_rate;
+      branch.sample_format = sample_format;
+      branch.sample_rate = sample_rate;
+      branch.sample_factor = sample_rate == process->branch_tail->sample_rate ? 1 : 0;
       branch.return_flags = dc::e_okay;
       branch.return_vector = return_vector;
       branch.vector_assign_lb = process->branch_tail->vector_assign_ub;
@@ -978,7 +1017,12 @@ void  apu::dsp_push(process_base_t* process, branch_base_t&  branch, int return_
       process->branch_tail = std::addressof(branch);
 }
 
-int   apu::dsp_fork(process_base_t* process, core* target, unsigned int op, unsigned int flags) noexcept
+/* dsp_fork()
+   render the target onto a branch of its own and transfer the result according to `op`; the result is delivered in the
+   given format, or in the format of the calling branch if `fmt_undef`; a target that renders at a rate of its own has its
+   result handed back as rendered, for the caller to resample (see dsp_resample())
+*/
+int   apu::dsp_fork(process_base_t* process, core* target, unsigned int op, unsigned int flags, unsigned int format) noexcept
 {
       auto     l_op = op;
       auto     l_flags = flags;
@@ -986,22 +1030,33 @@ int   apu::dsp_fork(process_base_t* process, core* target, unsigned int op, unsi
       int      l_source_vector;
       int      l_forward_vector;
       bool     l_source_success;
+      unsigned int l_return_format = format != fmt_undef ? format : process->branch_tail->sample_format;
+      unsigned int l_source_format = target->m_sample_format;
+      int      l_return_rate = process->branch_tail->sample_rate;
+      int      l_source_rate = target->m_sample_rate;
       branch_t l_branch;
 
+      if(l_source_format == fmt_undef) {
+          l_source_format = l_return_format;
+      }
+      if(l_source_rate == 0) {
+          l_source_rate = l_return_rate;
+      }
+
       // allocate return vectors for the branch in the current stack
       if(l_op & op_render) {
-          if(l_flags & ff_static) {
-              if(target->m_dov >= 0) {
-                  l_forward_vector = target->m_dov;
-              } else
-                  l_forward_vector = dvf_acquire(0, l_flags & ff_vector_flags);
+          if((l_flags & ff_static) &&
+              (target->m_dov >= 0)) {
+              l_forward_vector = target->m_dov;
           } else
-              l_forward_vector = dvf_acquire(0, l_flags & ff_vector_flags);
+          if(l_forward_vector = dvf_acquire(0, l_flags & ff_vector_flags); l_forward_vector != v_invalid) {
+              dvf_get_ptr(l_forward_vector)->r_format = l_source_format;
+          }
       } else
           l_forward_vector = l_return_vector;
 
       // create a new branch, push it on top of the rendering context
-      dsp_push(process, l_branch, l_forward_vector);
+      dsp_push(process, l_branch, l_forward_vector, l_source_format, l_source_rate);
 
       // render onto the new branch
       l_source_vector  = dsp_descend(process, target, l_op & op_resync);
@@ -1014,14 +1069,55 @@ int   apu::dsp_fork(process_base_t* process, core* target, unsigned int op, unsi
           if(l_op & op_render) {
               // transfer the data from the uplevel branch return vector onto the current branch's return vector and
               // set the return vector accordingly
+              if(l_source_rate != l_return_rate) {
+                  // the frame counts of the two branches differ: leave the conversion to the caller
+                  l_return_vector = l_source_vector;
+              } else
+              if(l_source_format != l_return_format) {
+                  // the branch rendered in a different format: convert onto the current branch's return vector, or onto
+                  // a vector of its own if the result isn't to be transferred
+                  if(fmt_get_mode(l_source_format) != fmt_get_mode(l_return_format)) {
+                      printdbg(
+                          "Cannot convert sample format %.2x to %.2x.\n",
+                          __FILE__,
+                          __LINE__,
+                          l_source_format,
+                          l_return_format
+                      );
+                      return v_invalid;
+                  }
+                  if((l_op & (op_copy | op_mix)) == 0) {
+                      l_return_vector = dvf_acquire();
+                      if(l_return_vector == v_invalid) {
+                          return v_invalid;
+                      }
+                      dvf_get_ptr(l_return_vector)->r_format = l_return_format;
+                  }
+                  fptype* p_return_vector = dvf_get_data_immediate(l_return_vector);
+                  fptype* p_source_vector = dvf_get_data_immediate(l_source_vector);
+                  if((p_return_vector == nullptr) ||
+                      (p_source_vector == nullptr)) {
+                      return v_invalid;
+                  }
+                  pcm_map(
+                      p_return_vector,
+                      fmt_get_sample_size(l_return_format),
+                      dsp_get_channel_stride(l_return_format),
+                      p_source_vector,
+                      fmt_get_sample_size(l_source_format),
+                      dsp_get_channel_stride(l_source_format),
+                      dsp_get_sample_count(),
+                      l_op & op_mix
+                  );
+              } else
               if(l_return_vector != l_source_vector) {
                   fptype* p_return_vector = dvf_get_data_immediate(l_return_vector);
                   fptype* p_source_vector = dvf_get_data_immediate(l_source_vector);
                   if(l_op & op_copy) {
-                      pcm_mov(p_return_vector, p_source_vector, dsp_get_sample_count());
+                      pcm_mov(p_return_vector, p_source_vector, dsp_get_vector_size());
                   } else
                   if(l_op & op_mix) {
-                      pcm_add(p_return_vector, p_source_vector, dsp_get_sample_count());
+                      pcm_add(p_return_vector, p_source_vector, dsp_get_vector_size());
                   } else
                       l_return_vector = l_source_vector;
               } else
@@ -1044,44 +1140,222 @@ int   apu::dsp_fork(process_base_t* process, core* target, unsigned int op, unsi
       return v_invalid;
 }
 
+/* dsp_resample()
+   render a source that runs at a rate other than that of the calling branch onto a branch of its own and bring the result
+   over to the rate of the calling branch, through the rate converter of the gate the source is attached to; the result is
+   delivered in the given format, or in the format of the calling branch if `fmt_undef`
+*/
+int   apu::dsp_resample(process_base_t* process, gate* gate, core* source, unsigned int op, unsigned int format) noexcept
+{
+      unsigned int l_return_format = format != fmt_undef ? format : process->branch_tail->sample_format;
+      unsigned int l_source_format = source->m_sample_format;
+      int      l_return_rate = process->branch_tail->sample_rate;
+      int      l_source_rate = source->m_sample_rate;
+      int      l_source_vector;
+      int      l_return_vector;
+
+      if(l_source_format == fmt_undef) {
+          l_source_format = l_return_format;
+      }
+      if((fmt_get_mode(l_source_format) != mode_pcm) ||
+          (fmt_get_mode(l_return_format) != mode_pcm)) {
+          printdbg(
+              "Cannot resample sample format %.2x to %.2x.\n",
+              __FILE__,
+              __LINE__,
+              l_source_format,
+              l_return_format
+          );
+          return v_invalid;
+      }
+
+      // render the source at its own rate and in its own format
+      l_source_vector = dsp_fork(process, source, op & op_resync, ff_default, l_source_format);
+      if(l_source_vector == v_invalid) {
+          return v_invalid;
+      }
+
+      // set up the converter of the gate, if it wasn't already when the gate was attached or the rates were set
+      int  l_channels = fmt_get_sample_size(l_source_format);
+      if(gate->make_resampler(l_source_rate, l_return_rate, l_channels) == false) {
+          return v_invalid;
+      }
+
+      // resample onto a vector of the calling branch, still in the format of the source; the source frame count is the one
+      // the branch the source was rendered on had, taken from an empty branch pushed at the same rate
+      branch_t l_source_branch;
+      dsp_push(process, l_source_branch, v_invalid, l_source_format, l_source_rate);
+      int  l_source_frames = dsp_get_sample_count();
+      dsp_pop(process, l_source_branch);
+      int  l_source_stride = 0;
+      if(fmt_is_planar(l_source_format)) {
+          l_source_stride = get_round_value(l_source_frames, memory_vector_block);
+      }
+      l_return_vector = dvf_acquire();
+      if(l_return_vector == v_invalid) {
+          return v_invalid;
+      }
+      dvf_get_ptr(l_return_vector)->r_format = l_source_format;
+      fptype* p_return_vector = dvf_get_data_immediate(l_return_vector);
+      fptype* p_source_vector = dvf_get_data_immediate(l_source_vector);
+      if((p_return_vector == nullptr) ||
+          (p_source_vector == nullptr)) {
+          return v_invalid;
+      }
+      gate->m_resampler->process(
+          p_return_vector,
+          dsp_get_sample_count(),
+          dsp_get_channel_stride(l_source_format),
+          p_source_vector,
+          l_source_frames,
+          l_source_stride
+      );
+
+      // and convert the format, if need be
+      if(l_source_format != l_return_format) {
+          int l_map_vector = dvf_acquire();
+          if(l_map_vector == v_invalid) {
+              return v_invalid;
+          }
+          dvf_get_ptr(l_map_vector)->r_format = l_return_format;
+          fptype* p_map_vector = dvf_get_data_immediate(l_map_vector);
+          if(p_map_vector == nullptr) {
+              return v_invalid;
+          }
+          pcm_map(
+              p_map_vector,
+              fmt_get_sample_size(l_return_format),
+              dsp_get_channel_stride(l_return_format),
+              p_return_vector,
+              l_channels,
+              dsp_get_channel_stride(l_source_format),
+              dsp_get_sample_count()
+          );
+          l_return_vector = l_map_vector;
+      }
+      return l_return_vector;
+}
+
 int   apu::dsp_descend(process_base_t* process, core* target, unsigned int op) noexcept
 {
       auto l_op = op;
       int  l_return_vector = target->m_dov;
 
+      if((target->m_sample_rate != 0) &&
+          (target->m_sample_rate != process->branch_tail->sample_rate)) {
+          // node renders at a rate of its own, but isn't reached through a gate that could convert it (e.g. it is attached
+          // directly to the apu): its result would come back with the wrong frame count
+          printdbg(
+              "Cannot render node `%p` at %d Hz onto a branch at %d Hz.\n",
+              __FILE__,
+              __LINE__,
+              target,
+              target->m_sample_rate,
+              process->branch_tail->sample_rate
+          );
+          return v_invalid;
+      }
       if(target->m_dcc > 1) {
           // node is referenced multiple times: fork a new branch such that its result is cached onto the branch return vector
           target->m_dcc = 0 - target->m_dcc;
           l_return_vector = dsp_fork(process, target, l_op | op_copy, ff_static);
           target->m_dcc = 0 - target->m_dcc;
       } else
+      if((target->m_sample_format != fmt_undef) &&
+          (target->m_sample_format != process->branch_tail->sample_format)) {
+          // node renders in a format of its own: give it a branch of its own and convert the result back
+          if(l_op & op_mix) {
+              l_return_vector = dsp_fork(process, target, l_op, ff_default);
+          } else
+              l_return_vector = dsp_fork(process, target, l_op | op_copy, ff_default);
+      } else
       if(target->m_hash != m_iteration_fingerprint) {
           int    l_source_count   = 0;
           int    l_source_success = 0;
+          int    l_branch_count   = 0;
+          unsigned int l_input_format = target->m_input_format;
+          int    l_input_factor = target->m_input_factor;
           gate*  i_gate = target->m_gate_head;
+          branch_t l_input_branch;
+          // the node takes its inputs in a format other than its own: the inputs can't share its return vector
+          if(l_input_format == process->branch_tail->sample_format) {
+              l_input_format = fmt_undef;
+          }
           // pre-visit node setup
           target->m_dov  = process->branch_tail->return_vector;
           target->m_dpc  = abs(target->m_dcc);
+          if(l_input_factor > 1) {
+              // the node takes its inputs at a multiple of its own rate: render them on a branch of their own, pushed at
+              // that rate, whose vectors are handed over to the node's branch once the inputs are done
+              if(l_input_format == fmt_undef) {
+                  l_input_format = process->branch_tail->sample_format;
+              }
+              dsp_push(process, l_input_branch, v_invalid, l_input_format, process->branch_tail->sample_rate * l_input_factor);
+              l_input_branch.sample_factor = l_input_factor;
+              l_input_branch.return_vector = dvf_acquire();
+              if(l_input_branch.return_vector != v_invalid) {
+                  dvf_get_ptr(l_input_branch.return_vector)->r_format = l_input_format;
+              }
+              l_input_format = fmt_undef;
+          }
           // run through the child nodes in depth-first and dispatch the op
           while(i_gate != nullptr) {
               if(i_gate->m_enable_bit) {
                   if(core* l_source = i_gate->m_source; l_source != nullptr) {
                       int       l_source_vector;
                       vector_t* p_source_vector;
-                      if(l_source_count == 0) {
-                          l_source_vector = dsp_descend(process, l_source, l_op);
+                      if(l_source->m_option & core::o_port) {
+                          // external input: hand the caller's memory over to the gate, no vector is involved unless the
+                          // input is planar, in which case the interleaved input is laid out onto a vector of its own
+                          if(fptype* p_feed = dsp_feed(static_cast<port*>(l_source)); p_feed != nullptr) {
+                              unsigned int l_feed_format = l_input_format;
+                              if(l_feed_format == fmt_undef) {
+                                  l_feed_format = process->branch_tail->sample_format;
+                              }
+                              if(int l_stride = dsp_get_channel_stride(l_feed_format); l_stride > 0) {
+                                  int     l_channels = fmt_get_sample_size(l_feed_format);
+                                  int     l_input_vector = dvf_acquire();
+                                  fptype* p_input = nullptr;
+                                  if(l_input_vector != v_invalid) {
+                                      dvf_get_ptr(l_input_vector)->r_format = l_feed_format;
+                                      p_input = dvf_get_data_immediate(l_input_vector);
+                                  }
+                                  if(p_input != nullptr) {
+                                      pcm_map(p_input, l_channels, l_stride, p_feed, l_channels, 0, dsp_get_sample_count());
+                                  }
+                                  p_feed = p_input;
+                              }
+                              if(p_feed != nullptr) {
+                                  i_gate->bind(p_feed);
+                                  l_source_success++;
+                              }
+                          }
                       } else
-                          l_source_vector = dsp_fork(process, l_source, l_op, ff_default);
-                      if(l_source_vector != v_invalid) {
-                          p_source_vector = dvf_get_ptr(l_source_vector);
-                          i_gate->bind(p_source_vector->data);
-                          l_source_success++;
+                      if(true) {
+                          if((l_source->m_sample_rate != 0) &&
+                              (l_source->m_sample_rate != process->branch_tail->sample_rate)) {
+                              l_source_vector = dsp_resample(process, i_gate, l_source, l_op, l_input_format);
+                          } else
+                          if((l_branch_count == 0) &&
+                              (l_input_format == fmt_undef)) {
+                              l_source_vector = dsp_descend(process, l_source, l_op);
+                          } else
+                              l_source_vector = dsp_fork(process, l_source, l_op, ff_default, l_input_format);
+                          if(l_source_vector != v_invalid) {
+                              p_source_vector = dvf_get_ptr(l_source_vector);
+                              i_gate->bind(p_source_vector->data);
+                              l_source_success++;
+                          }
+                          l_branch_count++;
                       }
                       l_source_count++;
                   }
               }
               i_gate = i_gate->m_gate_next;
           }
+          if(l_input_factor > 1) {
+              dsp_join(process, l_input_branch);
+          }
           // perform the processing pertaining to the current node
           if(l_source_success == l_source_count) {
               bool l_render_assert = true;
@@ -1117,6 +1391,28 @@ int   apu::dsp_descend(process_base_t* process, core* target, unsigned int op) n
       return l_return_vector;
 }
 
+/* dsp_join()
+   return to the calling branch like dsp_pop() does, except that the vectors assigned on the branch are handed over to the
+   calling branch instead of being released
+*/
+void  apu::dsp_join(process_base_t* process, branch_base_t& branch) noexcept
+{
+      if(process->branch_tail == std::addressof(branch)) {
+          process->branch_tail = branch.branch_parent;
+          if(process->branch_tail->vector_assign_ub < branch.vector_assign_ub) {
+              process->branch_tail->vector_assign_ub = branch.vector_assign_ub;
+          }
+          process->branch_tail->return_flags |= branch.return_flags;
+      } else
+          printdbg(
+              "Unmatched stack tail `%p` != `%p`\n",
+              __FILE__,
+              __LINE__,
+              std::addressof(branch),
+              process->branch_tail
+          );
+}
+
 void  apu::dsp_pop(process_base_t* process, branch_base_t& branch) noexcept
 {
       if(process->branch_tail == std::addressof(branch)) {
@@ -1136,6 +1432,18 @@ void  apu::dsp_pop(process_base_t* process, branch_base_t& branch) noexcept
           );
 }
 
+/* dsp_feed()
+   get the external memory bound to the given port for the current render pass
+*/
+fptype* apu::dsp_feed(port* node) noexcept
+{
+      if(node->m_hash != m_iteration_fingerprint) {
+          node->m_feed_ptr = node->feed(dsp_get_sample_count());
+          node->m_hash = m_iteration_fingerprint;
+      }
+      return node->m_feed_ptr;
+}
+
 void  apu::dsp_sync(core* node, float dt) noexcept
 {
       gate* i_gate = node->m_gate_head;
@@ -1159,6 +1467,187 @@ void  apu::dsp_reset_fingerprint() noexcept
           (reinterpret_cast<std::size_t>(this) & std::numeric_limits<unsigned int>::max());
 }
 
+/* dsp_render()
+   run through the active processes and render; when an output list is given, the return vector of each root process is
+   bound directly onto the caller supplied memory, such that the final result never has to be copied out of the sample store;
+   in `mix` mode all the processes are summed onto the first (and only) output: the first process to render is bound to it
+   and the ones that follow are added on top
+*/
+bool  apu::dsp_render(float dt, fptype** out_v, int out_c, int frames, bool mix) noexcept
+{
+      dc_t         l_dc;
+      bool         l_rs;
+      unsigned int l_op = op_render;
+      if(m_process_head != nullptr) {
+          l_rs = true;
+          s_process = m_process_head;
+          m_busy = true;
+          dsp_save(l_dc, this);
+          if(true) {
+              int        l_render_count = 0;
+              int        l_render_success = 0;
+              int        l_process_index = 0;
+              bool       l_mix_ready = false;
+              bool       l_descend_success;
+              int        l_descend_vector;
+              process_t* i_process;
+
+              // we have a sync operation included into this render, react as such
+              if(dt > 0.0f) {
+                  l_op = l_op | op_sync;
+              }
+              // update fingerprint
+              dsp_reset_fingerprint();
+
+              // run through the active processes and render
+              while(s_process != nullptr) {
+                  if(s_process->state != dc::pc_state_suspend) {
+                      if(s_process->dt += dt;
+                          s_process->dt >= 0.0f) {
+                          fptype* l_out_ptr = nullptr;
+                          bool    l_out_mix = false;
+                          bool    l_out_success = true;
+                          int     l_out_size = dsp_get_sample_count() * dsp_get_sample_size();
+                          int     l_out_stride = dsp_get_channel_stride();
+                          if(out_c > 0) {
+                              if(mix) {
+                                  l_out_ptr = out_v[0];
+                                  l_out_mix = l_mix_ready;
+                              } else
+                              if(l_process_index < out_c) {
+                                  l_out_ptr = out_v[l_process_index];
+                              }
+                          }
+                          s_process->return_flags = dc::e_okay;
+                          s_process->return_vector = dvf_acquire();
+                          if(l_out_ptr != nullptr) {
+                              if(l_out_size <= frames * dsp_get_sample_size()) {
+                                  // output buffers are interleaved: planar renders are laid out onto them once done
+                                  if(l_out_mix == false) {
+                                      if(l_out_stride == 0) {
+                                          l_out_success = dvf_bind(s_process->return_vector, l_out_ptr, l_out_size);
+                                      }
+                                  }
+                              } else
+                              if(true) {
+                                  printdbg(
+                                      "Output buffer of %d frames is too small for a render of %d samples.\n",
+                                      __FILE__,
+                                      __LINE__,
+                                      frames,
+                                      l_out_size
+                                  );
+                                  l_out_success = false;
+                              }
+                          }
+                          if(l_out_success) {
+                              l_descend_vector = dsp_descend(s_process, s_process->owner, l_op);
+                              l_descend_success = l_descend_vector != v_invalid;
+                          } else
+                              l_descend_success = false;
+                          if(l_descend_success) {
+                              if(l_out_ptr != nullptr) {
+                                  if(l_out_stride > 0) {
+                                      pcm_map(
+                                          l_out_ptr,
+                                          dsp_get_sample_size(),
+                                          0,
+                                          dvf_get_data_immediate(l_descend_vector),
+                                          dsp_get_sample_size(),
+                                          l_out_stride,
+                                          dsp_get_sample_count(),
+                                          l_out_mix
+                                      );
+                                  } else
+                                  if(l_out_mix) {
+                                      pcm_add(l_out_ptr, dvf_get_data_immediate(l_descend_vector), l_out_size);
+                                  } else
+                                  if(l_descend_vector != s_process->return_vector) {
+                                      // the result did not land on the vector bound to the output (a cached or forwarded
+                                      // vector was returned instead): copy it over
+                                      pcm_mov(l_out_ptr, dvf_get_data_immediate(l_descend_vector), l_out_size);
+                                  }
+                                  l_mix_ready = true;
+                              }
+                              s_process->time += s_process->dt;
+                              if(s_process->time >= 1.0f) {
+                                  s_process->time -= 1.0f;
+                              }
+                              s_process->omega += s_process->dt * std::numbers::pi * 2.0f;
+                              if(s_process->omega >= std::numbers::pi * 2.0f) {
+                                  s_process->omega -= std::numbers::pi * 2.0f;
+                              }
+                              s_process->dt = 0.0f;
+                              l_render_success++;
+                          }
+                          dvf_clear(true);
+                          dss_clear();
+                          l_render_count++;
+                      }
+                  }
+                  i_process = static_cast<process_t*>(s_process);
+                  s_process = i_process->next;
+                  l_process_index++;
+              }
+              dps_clear();
+
+              // nothing was rendered onto the mixed output: silence it
+              if(mix) {
+                  if(out_c > 0) {
+                      if(l_mix_ready == false) {
+                          pcm_clr(out_v[0], frames * fmt_get_sample_size(m_sample_format));
+                      }
+                  }
+              }
+              l_rs = l_render_success == l_render_count;
+          }
+          dsp_restore(l_dc);
+          m_busy = false;
+          s_process = nullptr;
+          return l_rs;
+      }
+      return false;
+}
+
+/* dsp_ahead_run()
+   render thread: keep rendering blocks onto the ring for as long as the latency limit allows, then sleep until the consumer
+   pulls
+*/
+void  apu::dsp_ahead_run() noexcept
+{
+      int   l_block_size = m_ahead_frames * fmt_get_sample_size(m_sample_format);
+      float l_block_dt   = static_cast<float>(m_ahead_frames) / static_cast<float>(m_sample_rate);
+      while(m_ahead_run.load()) {
+          unsigned int l_wake = m_ahead_wake.load();
+          if(m_ahead_ring.get_read_size() + l_block_size <= m_ahead_limit) {
+              bool l_render_success = render(l_block_dt, m_ahead_buffer, m_ahead_frames);
+              if(l_render_success == false) {
+                  // a failed render may not have touched the buffer: hand out silence instead, and back off until the
+                  // consumer pulls rather than retrying straight away
+                  pcm_clr(m_ahead_buffer, l_block_size);
+                  m_ahead_fault_count.fetch_add(1u, std::memory_order_relaxed);
+              }
+              m_ahead_ring.write(m_ahead_buffer, l_block_size);
+              m_ahead_render_count.fetch_add(1u, std::memory_order_relaxed);
+              if(l_render_success == false) {
+                  m_ahead_idle.store(true);
+                  if(m_ahead_run.load()) {
+                      m_ahead_wake.wait(l_wake);
+                  }
+                  m_ahead_idle.store(false);
+              }
+          } else
+          if(true) {
+              m_ahead_stall_count.fetch_add(1u, std::memory_order_relaxed);
+              m_ahead_idle.store(true);
+              if(m_ahead_ring.get_read_size() + l_block_size > m_ahead_limit) {
+                  m_ahead_wake.wait(l_wake);
+              }
+              m_ahead_idle.store(false);
+          }
+      }
+}
+
 void  apu::dsp_join_event(core*) noexcept
 {
 }
@@ -1219,62 +1708,28 @@ bool  apu::render() noexcept
 
 bool  apu::render(float dt) noexcept
 {
-      dc_t         l_dc;
-      bool         l_rs;
-      unsigned int l_op = op_render;
-      if(m_process_head != nullptr) {
-          l_rs = true;
-          s_process = m_process_head;
-          m_busy = true;
-          dsp_save(l_dc, this);
-          if(true) {
-              int        l_render_count = 0;
-              int        l_render_success = 0;
-              bool       l_descend_success;
-              process_t* i_process;
+      return dsp_render(dt, nullptr, 0, 0, false);
+}
 
-              // we have a sync operation included into this render, react as such
-              if(dt > 0.0f) {
-                  l_op = l_op | op_sync;
-              }
-              // update fingerprint
-              dsp_reset_fingerprint();
+/* render()
+   render all the attached processes and sum their results onto `out`, which must be able to hold `frames` frames
+*/
+bool  apu::render(float dt, fptype* out, int frames) noexcept
+{
+      if(out != nullptr) {
+          return dsp_render(dt, std::addressof(out), 1, frames, true);
+      }
+      return false;
+}
 
-              // run through the active processes and render
-              while(s_process != nullptr) {
-                  if(s_process->state != dc::pc_state_suspend) {
-                      if(s_process->dt += dt;
-                          s_process->dt >= 0.0f) {
-                          s_process->return_flags = dc::e_okay;
-                          s_process->return_vector = dvf_acquire();
-                          l_descend_success = dsp_descend(s_process, s_process->owner, l_op) != v_invalid;
-                          if(l_descend_success) {
-                              s_process->time += s_process->dt;
-                              if(s_process->time >= 1.0f) {
-                                  s_process->time -= 1.0f;
-                              }
-                              s_process->omega += s_process->dt * std::numbers::pi * 2.0f;
-                              if(s_process->omega >= std::numbers::pi * 2.0f) {
-                                  s_process->omega -= std::numbers::pi * 2.0f;
-                              }
-                              s_process->dt = 0.0f;
-                              l_render_success++;
-                          }
-                          dvf_clear(true);
-                          dss_clear();
-                          l_render_count++;
-                      }
-                  }
-                  i_process = static_cast<process_t*>(s_process);
-                  s_process = i_process->next;
-              }
-              dps_clear();
-              l_rs = l_render_success == l_render_count;
-          }
-          dsp_restore(l_dc);
-          m_busy = false;
-          s_process = nullptr;
-          return l_rs;
+/* render()
+   render the attached processes, each one onto its own output from `out`, in the order in which they were attached;
+   processes that don't have a matching (non-null) output are rendered internally
+*/
+bool  apu::render(float dt, fptype** out, int count, int frames) noexcept
+{
+      if(out != nullptr) {
+          return dsp_render(dt, out, count, frames, false);
       }
       return false;
 }
@@ -1303,6 +1758,97 @@ bool  apu::sync(float dt) noexcept
       return true;
 }
 
+/* start()
+   spawn a render thread that renders the attached graph ahead of the consumer, in blocks of `frames` frames and up to
+   `blocks` blocks ahead; the rendered data is collected by the consumer with pull();
+   larger blocks trade latency for throughput, as the per-pass overhead is spread over more samples; the graph and the apu
+   settings must not be changed and render() must not be called for as long as the render thread is running
+*/
+bool  apu::start(int frames, int blocks) noexcept
+{
+      if(m_ahead_run.load() == false) {
+          if((frames > 0) &&
+              (blocks > 0)) {
+              int l_block_size = frames * fmt_get_sample_size(m_sample_format);
+              if(m_ahead_ring.reset(l_block_size * blocks)) {
+                  m_ahead_buffer = reinterpret_cast<fptype*>(malloc(l_block_size * sizeof(fptype)));
+                  if(m_ahead_buffer != nullptr) {
+                      m_ahead_frames = frames;
+                      m_ahead_limit = l_block_size * blocks;
+                      m_ahead_render_count.store(0u);
+                      m_ahead_fault_count.store(0u);
+                      m_ahead_stall_count.store(0u);
+                      m_ahead_underrun_count.store(0u);
+                      m_ahead_run.store(true);
+                      m_ahead_thread = std::thread(&apu::dsp_ahead_run, this);
+                      return true;
+                  }
+                  m_ahead_ring.dispose();
+              }
+          }
+      }
+      return false;
+}
+
+/* pull()
+   collect `frames` frames rendered ahead by the render thread; never blocks: if not enough frames are available the rest
+   of the buffer is silenced and the underrun is accounted for in the stats; returns the number of frames that were available
+*/
+int   apu::pull(fptype* out, int frames) noexcept
+{
+      if(m_ahead_run.load(std::memory_order_relaxed)) {
+          int l_sample_size = fmt_get_sample_size(m_sample_format);
+          int l_size = frames * l_sample_size;
+          int l_pull = m_ahead_ring.read(out, l_size);
+          if(l_pull < l_size) {
+              pcm_clr(out + l_pull, l_size - l_pull);
+              m_ahead_underrun_count.fetch_add(1u, std::memory_order_relaxed);
+          }
+          m_ahead_wake.fetch_add(1u);
+          if(m_ahead_idle.load()) {
+              m_ahead_wake.notify_one();
+          }
+          return l_pull / l_sample_size;
+      }
+      return 0;
+}
+
+/* stop()
+   stop and join the render thread, drop the data rendered ahead
+*/
+void  apu::stop() noexcept
+{
+      if(m_ahead_run.load()) {
+          m_ahead_run.store(false);
+          m_ahead_wake.fetch_add(1u);
+          m_ahead_wake.notify_one();
+          m_ahead_thread.join();
+          m_ahead_ring.dispose();
+          free(m_ahead_buffer);
+          m_ahead_buffer = nullptr;
+          m_ahead_frames = 0;
+          m_ahead_limit = 0;
+      }
+}
+
+bool  apu::get_ahead_stats(ahead_stats_t& stats) const noexcept
+{
+      if(m_ahead_run.load(std::memory_order_relaxed)) {
+          stats.render_count = m_ahead_render_count.load(std::memory_order_relaxed);
+          stats.fault_count = m_ahead_fault_count.load(std::memory_order_relaxed);
+          stats.stall_count = m_ahead_stall_count.load(std::memory_order_relaxed);
+          stats.underrun_count = m_ahead_underrun_count.load(std::memory_order_relaxed);
+          stats.queued_frames = m_ahead_ring.get_read_size() / fmt_get_sample_size(m_sample_format);
+          return true;
+      }
+      return false;
+}
+
+bool  apu::is_running() const noexcept
+{
+      return m_ahead_run.load(std::memory_order_relaxed);
+}
+
 unsigned int apu::get_sample_format() const noexcept
 {
       return m_sample_format;
@@ -1310,11 +1856,12 @@ unsigned int apu::get_sample_format() const noexcept
 
 bool  apu::set_sample_format(unsigned int value) noexcept
 {
-      if((value == fmt_pcm_1) ||
-          (value == fmt_pcm_2) ||
-          (value == fmt_pcm_4) ||
-          (value == fmt_pcm_8) ||
-          (value == fmt_apm)) {
+      if(fmt_is_valid(value)) {
+          process_t* i_process = m_process_head;
+          while(i_process != nullptr) {
+              i_process->sample_format = value;
+              i_process = i_process->next;
+          }
           m_sample_format = value;
           return true;
       }
@@ -1330,12 +1877,32 @@ bool  apu::set_sample_rate(int value) noexcept
 {
       if(value >= min_sample_rate) {
           if(value <= max_sample_rate) {
+              process_t* i_process = m_process_head;
+              while(i_process != nullptr) {
+                  i_process->sample_rate = value;
+                  i_process = i_process->next;
+              }
+              m_sample_rate = value;
               return true;
           }
       }
       return false;
 }
 
+/* get_frame_limit()
+   largest number of frames a single vector supplied by the sample store can hold in the current sample format
+*/
+int   apu::get_frame_limit() const noexcept
+{
+      int l_page_samples = memory_vector_page / sizeof(fptype) - memory_vector_block;
+      int l_page_blocks  = l_page_samples / memory_vector_block;
+      if(fmt_is_planar(m_sample_format)) {
+          // each channel run is padded to whole blocks
+          return l_page_blocks / fmt_get_sample_size(m_sample_format) * memory_vector_block;
+      }
+      return l_page_blocks * memory_vector_block / fmt_get_sample_size(m_sample_format);
+}
+
 bool  apu::is_attached(core* core, bool expected_result) const noexcept
 {
       bool l_attached;
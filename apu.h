@@ -24,6 +24,9 @@
 #include "dsp.h"
 #include "dc.h"
 #include "config.h"
+#include "ring.h"
+#include <atomic>
+#include <thread>
 
 namespace dsp {
 
@@ -35,6 +38,7 @@ class apu: public dc
   struct vector_t: public vector_base_t
   {
     short int r_size;         // requested size
+    unsigned char r_format;   // format to size an automatic vector for; fmt_undef for the format of the accessing branch
     bool      r_keep:1;       // requested persistance attribute
     bool      s_far_bit:1;    // far attribute: memory referenced by the vector is not allocated internally
     bool      s_keep_bit:1;
@@ -110,6 +114,32 @@ class apu: public dc
   unsigned int  m_iteration_fingerprint;
   bool          m_busy;
 
+  ring          m_ahead_ring;
+  std::thread   m_ahead_thread;
+  fptype*       m_ahead_buffer;
+  int           m_ahead_frames;     // frames rendered in a single pass of the render thread
+  int           m_ahead_limit;      // maximum number of samples to render ahead of the consumer
+  std::atomic<bool>          m_ahead_run;
+  std::atomic<bool>          m_ahead_idle;
+  std::atomic<unsigned int>  m_ahead_wake;
+  std::atomic<unsigned int>  m_ahead_render_count;
+  std::atomic<unsigned int>  m_ahead_fault_count;
+  std::atomic<unsigned int>  m_ahead_stall_count;
+  std::atomic<unsigned int>  m_ahead_underrun_count;
+
+  public:
+  /* ahead_stats_t
+     render-ahead statistics
+  */
+  struct ahead_stats_t
+  {
+    unsigned int  render_count;       // blocks rendered by the render thread
+    unsigned int  fault_count;        // blocks that failed to render
+    unsigned int  stall_count;        // times the render thread caught up with the latency limit and had to wait
+    unsigned int  underrun_count;     // pull() requests that could not be (fully) served
+    int           queued_frames;      // frames currently rendered ahead
+  };
+
   protected:
           bool        dsg_find(core*) const noexcept;
           void        dsg_bind(core*) noexcept;
@@ -155,6 +185,7 @@ class apu: public dc
           fptype*     dvf_get_data_lazy(int) const noexcept;
           fptype*     dvf_get_data_immediate(int) noexcept;
           int         dvf_acquire(int = 0, unsigned int = 0) noexcept;
+          bool        dvf_bind(int, fptype*, int) noexcept;
           void        dvf_release(int, bool) noexcept;
           void        dvf_clear(bool = true) noexcept;
           void        dvf_dispose(bool = true) noexcept;
@@ -165,14 +196,19 @@ class apu: public dc
           process_t*  dsp_free_process(process_t*) noexcept;
           void        dsp_dispose_process_list() noexcept;
 
-          void        dsp_push(process_base_t*, branch_base_t&, int) noexcept;
-          int         dsp_fork(process_base_t*, core*, unsigned int, unsigned int) noexcept;
+          void        dsp_push(process_base_t*, branch_base_t&, int, unsigned int, int) noexcept;
+          int         dsp_fork(process_base_t*, core*, unsigned int, unsigned int, unsigned int = fmt_undef) noexcept;
+          int         dsp_resample(process_base_t*, gate*, core*, unsigned int, unsigned int = fmt_undef) noexcept;
           int         dsp_descend(process_base_t*, core*, unsigned int) noexcept;
+          void        dsp_join(process_base_t*, branch_base_t&) noexcept;
           void        dsp_pop(process_base_t*, branch_base_t&) noexcept;
+          fptype*     dsp_feed(port*) noexcept;
           void        dsp_sync(core*, float) noexcept;
           void        dsp_reset_fingerprint() noexcept;
+          bool        dsp_render(float, fptype**, int, int, bool) noexcept;
 
   private:
+          void        dsp_ahead_run() noexcept;
           void        dsp_join_event(core*) noexcept;
           void        dsp_part_event(core*) noexcept;
 
@@ -200,11 +236,21 @@ class apu: public dc
 
           bool  render() noexcept;
           bool  render(float) noexcept;
+          bool  render(float, fptype*, int) noexcept;
+          bool  render(float, fptype**, int, int) noexcept;
           bool  sync(float) noexcept;
+
+          bool  start(int, int) noexcept;
+          int   pull(fptype*, int) noexcept;
+          void  stop() noexcept;
+          bool  get_ahead_stats(ahead_stats_t&) const noexcept;
+          bool  is_running() const noexcept;
+
           unsigned int get_sample_format() const noexcept;
           bool  set_sample_format(unsigned int) noexcept;
           int   get_sample_rate() const noexcept;
           bool  set_sample_rate(int) noexcept;
+          int   get_frame_limit() const noexcept;
 
           bool  is_attached(core*, bool = true) const noexcept;
 
@@ -24,12 +24,46 @@
 namespace dsp {
 
       atom::atom(unsigned int option) noexcept:
-      core(option)
+      core(option),
+      m_call_proc(call_none),
+      m_drop_proc(drop_none),
+      m_call_context(m_call_data),
+      m_r_base(nullptr)
 {
 }
 
       atom::~atom()
 {
+      drop_call();
+      if(m_r_base != nullptr) {
+          free(m_r_base);
+      }
+}
+
+/* call_none()
+   call thunk of an atom that has no call installed
+*/
+bool  atom::call_none(void*, unsigned int) noexcept
+{
+      return false;
+}
+
+void  atom::drop_none(void*) noexcept
+{
+}
+
+/* drop_call()
+   destroy the closure of the installed call and restore the empty thunks
+*/
+void  atom::drop_call() noexcept
+{
+      m_drop_proc(m_call_context);
+      if(m_call_context != m_call_data) {
+          free(m_call_context);
+      }
+      m_call_proc = call_none;
+      m_drop_proc = drop_none;
+      m_call_context = m_call_data;
 }
 
 /*namespace dsp*/ }
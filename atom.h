@@ -24,17 +24,32 @@
 #include "dsp.h"
 #include "core.h"
 #include "factory.h"
-#include <functional>
+#include "lattice/kernel.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace dsp {
 
-using call_t = std::function<bool(unsigned int)>;
+/* call_t
+   call thunk: a stub instantiated for the type of the closure installed by make_call() and invoked with the closure as
+   its context, so that render() reaches the user function through a single indirect call
+*/
+using call_t = bool(*)(void*, unsigned int) noexcept;
+using drop_t = void(*)(void*) noexcept;
 
 /* atom
 */
 class atom: public core
 {
-  call_t       m_call;
+  static constexpr int call_data_size = 64;
+
+  call_t       m_call_proc;
+  drop_t       m_drop_proc;
+  void*        m_call_context;        // closure of the installed call: points into m_call_data if it fits, to the heap otherwise
+  alignas(std::max_align_t) std::uint8_t m_call_data[call_data_size];
+  fptype*      m_r_base;              // argument vectors followed by the register file, for functions that take fptype*
 
   public:
   /* ff_*
@@ -46,27 +61,207 @@ class atom: public core
   static constexpr unsigned int ff_sink = 3u;
 
   private:
+  template<int>
+  using   vector_t = fptype*;
+
+  /* get_member()
+     member function of a call, given either as a pointer to member or as a std::integral_constant holding one
+  */
+  template<typename Ft>
+  static constexpr auto get_member(Ft function) noexcept {
+          if constexpr(requires { Ft::value; }) {
+              return Ft::value;
+          } else
+              return function;
+  }
+
+  /* is_vector_call()
+     check whether the member function of a call takes its arguments as evaluated vectors rather than as argument&
+  */
+  template<typename Ot, typename Ft, int... Is>
+  static constexpr bool is_vector_call(std::integer_sequence<int, Is...>) noexcept {
+          return std::is_invocable_r_v<bool, decltype(get_member(std::declval<Ft>())), Ot*, unsigned int, vector_t<Is>...>;
+  }
+
   template<typename Ot, typename Ft, int... Is>
   inline  bool  call_impl(Ot object, Ft function, unsigned int op, std::integer_sequence<int, Is...> sequence) noexcept {
-          return (object->*function)(op, m_argv[Is]...);
+          return (object->*get_member(function))(op, m_argv[Is]...);
+  }
+
+  template<typename Ot, typename Ft, int... Is>
+  inline  bool  call_batch_impl(Ot object, Ft function, unsigned int op, micro* code_head, micro* code_tail, std::integer_sequence<int, Is...> sequence) noexcept {
+          if(rt_run_batch(code_head, code_tail, m_r_base + sizeof...(Is) * fpu::pts, m_r_base)) {
+              return (object->*get_member(function))(op, (m_r_base + Is * fpu::pts)...);
+          }
+          return false;
+  }
+
+  template<typename Ot, typename Ft, int... Is>
+  inline  bool  call_static_impl(Ot object, Ft function, unsigned int op, std::integer_sequence<int, Is...> sequence) noexcept {
+          return (object->*function)(op, (m_d_base + Is * fpu::pts)...);
+  }
+
+  static  bool  call_none(void*, unsigned int) noexcept;
+  static  void  drop_none(void*) noexcept;
+
+          void  drop_call() noexcept;
+
+  /* set_call()
+     install a closure as the call of the atom, along with the thunks that invoke and destroy it
+  */
+  template<typename Ct>
+  inline  bool  set_call(Ct&& closure) noexcept {
+          using closure_t = std::remove_cvref_t<Ct>;
+          void* l_context;
+          drop_call();
+          if constexpr((sizeof(closure_t) <= call_data_size) &&
+              (alignof(closure_t) <= alignof(std::max_align_t))) {
+              l_context = m_call_data;
+          } else
+          if(l_context = malloc(sizeof(closure_t)); l_context == nullptr) {
+              return false;
+          }
+          new(l_context) closure_t(std::forward<Ct>(closure));
+          m_call_proc = [](void* context, unsigned int op) noexcept -> bool {
+              return (*reinterpret_cast<closure_t*>(context))(op);
+          };
+          m_drop_proc = [](void* context) noexcept {
+              reinterpret_cast<closure_t*>(context)->~closure_t();
+          };
+          m_call_context = l_context;
+          return true;
+  }
+
+  /* set_program_call()
+     install the call of an atom that holds compiled microcode: functions that take argument& evaluate their arguments on
+     their own, functions that take fptype* receive all of them evaluated in a single pass over the code of the atom, into
+     the vectors ahead of the register file at m_r_base
+  */
+  template<int Argc, typename Ot, typename Ft>
+  inline  bool  set_program_call(Ot* object, Ft function) noexcept {
+          if constexpr((Argc > 0) && is_vector_call<Ot, Ft>(std::make_integer_sequence<int, Argc>())) {
+              micro* l_code_head;
+              micro* l_code_tail;
+              micro* l_last_head;
+              m_argv[0].load(l_code_head, l_code_tail);
+              m_argv[Argc - 1].load(l_last_head, l_code_tail);
+              if(m_r_base != nullptr) {
+                  free(m_r_base);
+              }
+              m_r_base = reinterpret_cast<fptype*>(malloc((Argc + m_register_count) * fpu::pts * sizeof(fptype)));
+              if(m_r_base == nullptr) {
+                  return false;
+              }
+              return set_call([object,function,l_code_head,l_code_tail,this](unsigned int op) noexcept -> bool {
+                  return call_batch_impl(object, function, op, l_code_head, l_code_tail, std::make_integer_sequence<int, Argc>());
+              });
+          } else
+              return set_call([object,function,this](unsigned int op) noexcept -> bool {
+                  return call_impl(object, function, op, std::make_integer_sequence<int, Argc>());
+              });
   }
 
   protected:
+  /* make_call()
+     compile the given expressions into the microcode of the atom and install a call to `function` with them, see
+     set_program_call() for the forms the function may take
+  */
   template<typename Ot, typename Ft, typename... Args>
   inline  bool    make_call(Ot* object, Ft function, Args&&... arguments) noexcept {
           factory l_factory(std::forward<Args>(arguments)...);
           if(l_factory.get_return_status()) {
               move(l_factory);
-              m_call = [object,function,this](unsigned int op) noexcept -> bool {
-                  return call_impl(object, function, op, std::make_integer_sequence<int, sizeof...(Args)>());
+              return set_program_call<sizeof...(Args)>(object, function);
+          }
+          return false;
+  }
+
+  /* make_call<function>()
+     same as make_call(), with the member function given as a template argument: the thunk then calls it directly
+     instead of through a pointer to member, and it may be inlined into the thunk
+  */
+  template<auto Function, typename Ot, typename... Args>
+  inline  bool    make_call(Ot* object, Args&&... arguments) noexcept {
+          factory l_factory(std::forward<Args>(arguments)...);
+          if(l_factory.get_return_status()) {
+              move(l_factory);
+              return set_program_call<sizeof...(Args)>(object, std::integral_constant<decltype(Function), Function>());
+          }
+          return false;
+  }
+
+  /* make_static_call()
+     alternative to make_call() for expressions known at compile time: each argument is evaluated by a kernel instantiated
+     from its expression type instead of by interpreted microcode, and the function receives the results as fptype*
+     registers of fpu::pts lanes; the data block holds the result registers followed by one register per distinct uniform
+  */
+  template<typename Ot, typename Ft, typename... Args>
+  inline  bool    make_static_call(Ot* object, Ft function, Args&&... arguments) noexcept {
+          int l_variable_count = get_variable_count_ub(lift(arguments)...);
+          int l_data_size = (sizeof...(Args) + l_variable_count) * fpu::pts * sizeof(fptype);
+          if(l_data_size > std::numeric_limits<short int>::max()) {
+              return false;
+          }
+          if(make_storage(l_data_size, 0, 0)) {
+              m_variable_count = l_variable_count;
+              m_uniform_count = 0;
+              m_register_count = 0;
+              m_instruction_count = 0;
+              fptype* l_data_base = m_d_base + sizeof...(Args) * fpu::pts;
+              fptype* l_data_last = l_data_base;
+              std::memset(m_d_base, 0, m_d_size);
+              // bind every uniform that is not yet bound to this block to the next free data register
+              auto l_bind = [l_data_base, &l_data_last](uniform& symbol) noexcept {
+                  fptype* l_value_ptr = symbol;
+                  if((l_value_ptr < l_data_base) ||
+                      (l_value_ptr >= l_data_last)) {
+                      symbol.bind(l_data_last);
+                      l_data_last += fpu::pts;
+                  }
               };
-              return true;
+              (kernel_bind(lift(arguments), l_bind), ...);
+              return set_call([object, function, this, ...l_kernel = lift_t<Args>(lift(arguments))](unsigned int op) noexcept -> bool {
+                  int i_result = 0;
+                  ((kernel_eval(m_d_base + fpu::pts * i_result++, l_kernel)), ...);
+                  return call_static_impl(object, function, op, std::make_integer_sequence<int, sizeof...(Args)>());
+              });
+          }
+          return false;
+  }
+
+  /* load_call()
+     alternative to make_call() that skips the factory: the microcode is loaded from a program image saved by save_image()
+     for the same expressions, and their uniforms are rebound by position to the leading data registers of the image
+  */
+  template<typename Ot, typename Ft, typename... Args>
+  inline  bool    load_call(const std::uint8_t* image, std::uint64_t size, Ot* object, Ft function, Args&&... arguments) noexcept {
+          if(load_image(image, size)) {
+              if(m_argc == sizeof...(Args)) {
+                  int  l_uniform_count = 0;
+                  auto l_unbind = [](uniform& symbol) noexcept {
+                      symbol.unbind();
+                  };
+                  auto l_bind = [this, &l_uniform_count](uniform& symbol) noexcept {
+                      if(symbol.is_bound() == false) {
+                          if(l_uniform_count < m_uniform_count) {
+                              symbol.bind(m_d_base + l_uniform_count * fpu::pts);
+                          }
+                          l_uniform_count++;
+                      }
+                  };
+                  (kernel_bind(lift(arguments), l_unbind), ...);
+                  (kernel_bind(lift(arguments), l_bind), ...);
+                  if(l_uniform_count == m_uniform_count) {
+                      return set_program_call<sizeof...(Args)>(object, function);
+                  }
+              }
+              dispose();
           }
           return false;
   }
 
   inline  bool  render(unsigned int op) noexcept override {
-          return m_call(op);
+          return m_call_proc(m_call_context, op);
   }
 
   public:
@@ -0,0 +1,55 @@
+#ifndef dsp_biquad_h
+#define dsp_biquad_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "filter.h"
+
+namespace dsp {
+
+/* biquad
+   bank of cascaded biquad sections in transposed direct form II, with the RBJ cookbook responses
+*/
+class biquad: public filter
+{
+  alignas(32) fptype m_coeff[5][lane_max];      // b0, b1, b2, a1, a2 of each lane
+  fptype*   m_state;                            // z1, z2 of each lane, for each stage
+
+  protected:
+  virtual void    dsp_update(int, const param_t&, float) noexcept override;
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          biquad() noexcept;
+          biquad(int, int = 1) noexcept;
+          biquad(const biquad&) noexcept = delete;
+          biquad(biquad&&) noexcept = delete;
+  virtual ~biquad();
+
+  virtual void    reset() noexcept override;
+
+          biquad& operator=(const biquad&) noexcept = delete;
+          biquad& operator=(biquad&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
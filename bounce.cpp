@@ -0,0 +1,234 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bounce.h"
+#include "apu.h"
+#include "riff.h"
+#include <cmath>
+
+namespace dsp {
+
+      bounce::bounce(apu* apu_ptr) noexcept:
+      bounce(apu_ptr, ff_wave)
+{
+}
+
+      bounce::bounce(apu* apu_ptr, unsigned int format, int frames) noexcept:
+      m_apu(apu_ptr),
+      m_file(nullptr),
+      m_file_buffer(nullptr),
+      m_block_ptr(nullptr),
+      m_block_frames(frames),
+      m_file_format(format),
+      m_sample_size(0),
+      m_frame_count(0u)
+{
+}
+
+      bounce::~bounce()
+{
+      file_close();
+}
+
+bool  bounce::file_open(const char* path) noexcept
+{
+      m_file = std::fopen(path, "wb");
+      if(m_file != nullptr) {
+          m_file_buffer = reinterpret_cast<char*>(malloc(bounce_file_buffer));
+          if(m_file_buffer != nullptr) {
+              std::setvbuf(m_file, m_file_buffer, _IOFBF, bounce_file_buffer);
+          }
+          m_block_ptr = reinterpret_cast<fptype*>(malloc(m_block_frames * m_sample_size * sizeof(fptype)));
+          if(m_block_ptr != nullptr) {
+              return true;
+          }
+      }
+      file_close();
+      return false;
+}
+
+/* file_write_head()
+   write (or rewrite, once the data size is known) the WAV header; a `JUNK` chunk is reserved in front of the `fmt ` chunk,
+   such that it can be turned into a `ds64` chunk if the file needs to be promoted to RF64; samples are IEEE float, which
+   takes the extended `fmt ` chunk and a `fact` chunk, and the WAVE_FORMAT_EXTENSIBLE layout beyond 2 channels
+*/
+bool  bounce::file_write_head(bool final) noexcept
+{
+      if(m_file_format == ff_wave) {
+          riff_head_t   l_head;
+          riff_chunk_t  l_ds64_chunk;
+          riff_ds64_t   l_ds64;
+          riff_chunk_t  l_fmt_chunk;
+          riff_fmt_t    l_fmt;
+          riff_fmt_ext_t l_fmt_ext;
+          riff_chunk_t  l_fact_chunk;
+          std::uint32_t l_fact;
+          riff_chunk_t  l_data_chunk;
+          bool          l_extensible = m_sample_size > 2;
+          int           l_fmt_ext_size = l_extensible ? sizeof(riff_fmt_ext_t) : sizeof(l_fmt_ext.size);
+          std::uint64_t l_data_size = m_frame_count * m_sample_size * sizeof(fptype);
+          std::uint64_t l_riff_size =
+              sizeof(l_head.type) +
+              sizeof(riff_chunk_t) + riff_ds64_size +
+              sizeof(riff_chunk_t) + sizeof(riff_fmt_t) + l_fmt_ext_size +
+              sizeof(riff_chunk_t) + sizeof(l_fact) +
+              sizeof(riff_chunk_t) + l_data_size;
+          bool          l_rf64 = l_riff_size > riff_size_max;
+
+          std::memcpy(l_head.id, l_rf64 ? "RF64" : "RIFF", 4);
+          std::memcpy(l_head.type, "WAVE", 4);
+          l_head.size = l_rf64 ? riff_size_max : l_riff_size;
+
+          std::memcpy(l_ds64_chunk.id, l_rf64 ? "ds64" : "JUNK", 4);
+          l_ds64_chunk.size = riff_ds64_size;
+          std::memset(std::addressof(l_ds64), 0, sizeof(l_ds64));
+          if(l_rf64) {
+              l_ds64.riff_size = l_riff_size;
+              l_ds64.data_size = l_data_size;
+              l_ds64.sample_count = m_frame_count;
+          }
+
+          std::memcpy(l_fmt_chunk.id, "fmt ", 4);
+          l_fmt_chunk.size = sizeof(riff_fmt_t) + l_fmt_ext_size;
+          l_fmt.format_tag = l_extensible ? wave_format_extensible : wave_format_float;
+          l_fmt.channels = m_sample_size;
+          l_fmt.sample_rate = m_apu->get_sample_rate();
+          l_fmt.block_align = m_sample_size * sizeof(fptype);
+          l_fmt.byte_rate = l_fmt.sample_rate * l_fmt.block_align;
+          l_fmt.bits_per_sample = sizeof(fptype) * 8;
+          std::memset(std::addressof(l_fmt_ext), 0, sizeof(l_fmt_ext));
+          if(l_extensible) {
+              // KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+              constexpr std::uint8_t l_sub_format[16] = {
+                  0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71
+              };
+              l_fmt_ext.size = riff_fmt_ext_size;
+              l_fmt_ext.valid_bits_per_sample = l_fmt.bits_per_sample;
+              l_fmt_ext.channel_mask = riff_get_channel_mask(m_sample_size);
+              std::memcpy(l_fmt_ext.sub_format, l_sub_format, sizeof(l_sub_format));
+          }
+
+          // frame count, required for formats other than integer PCM; an RF64 file carries it in the `ds64` chunk instead
+          std::memcpy(l_fact_chunk.id, "fact", 4);
+          l_fact_chunk.size = sizeof(l_fact);
+          l_fact = l_rf64 ? riff_size_max : m_frame_count;
+
+          std::memcpy(l_data_chunk.id, "data", 4);
+          l_data_chunk.size = l_rf64 ? riff_size_max : l_data_size;
+
+          if(final) {
+              if(std::fseek(m_file, 0, SEEK_SET) != 0) {
+                  return false;
+              }
+          }
+          if((std::fwrite(std::addressof(l_head), sizeof(l_head), 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_ds64_chunk), sizeof(l_ds64_chunk), 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_ds64), riff_ds64_size, 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_fmt_chunk), sizeof(l_fmt_chunk), 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_fmt), sizeof(l_fmt), 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_fmt_ext), l_fmt_ext_size, 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_fact_chunk), sizeof(l_fact_chunk), 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_fact), sizeof(l_fact), 1, m_file) == 1) &&
+              (std::fwrite(std::addressof(l_data_chunk), sizeof(l_data_chunk), 1, m_file) == 1)) {
+              return true;
+          }
+          return false;
+      }
+      return true;
+}
+
+bool  bounce::file_write_data(int frames) noexcept
+{
+      std::size_t l_size = frames * m_sample_size;
+      if(std::fwrite(m_block_ptr, sizeof(fptype), l_size, m_file) == l_size) {
+          m_frame_count += frames;
+          return true;
+      }
+      return false;
+}
+
+void  bounce::file_close() noexcept
+{
+      if(m_file != nullptr) {
+          std::fclose(m_file);
+          m_file = nullptr;
+      }
+      if(m_file_buffer != nullptr) {
+          free(m_file_buffer);
+          m_file_buffer = nullptr;
+      }
+      if(m_block_ptr != nullptr) {
+          free(m_block_ptr);
+          m_block_ptr = nullptr;
+      }
+}
+
+/* run()
+   render `duration` seconds of the graph attached to the apu into the file at `path`;
+   the block size is only bounded by the size of the vectors the sample store can supply, so the per-pass overhead of the
+   apu is spread across many more samples than with device sized blocks
+*/
+bool  bounce::run(const char* path, float duration) noexcept
+{
+      bool  l_success = false;
+      if(m_apu != nullptr) {
+          if(m_apu->is_running() == false) {
+              if(m_block_frames > 0) {
+                  if(m_block_frames > m_apu->get_frame_limit()) {
+                      m_block_frames = m_apu->get_frame_limit();
+                  }
+                  m_sample_size = fmt_get_sample_size(m_apu->get_sample_format());
+                  m_frame_count = 0u;
+                  if(file_open(path)) {
+                      int           l_sample_rate = m_apu->get_sample_rate();
+                      std::uint64_t l_frame_count = std::llround(static_cast<double>(duration) * l_sample_rate);
+                      std::uint64_t l_frame_index = 0u;
+                      l_success = file_write_head(false);
+                      while(l_success &&
+                          (l_frame_index < l_frame_count)) {
+                          int   l_block_frames = m_block_frames;
+                          if(l_frame_count - l_frame_index < static_cast<std::uint64_t>(l_block_frames)) {
+                              l_block_frames = l_frame_count - l_frame_index;
+                          }
+                          float l_block_dt = static_cast<float>(l_block_frames) / static_cast<float>(l_sample_rate);
+                          if(m_apu->render(l_block_dt, m_block_ptr, l_block_frames)) {
+                              l_success = file_write_data(l_block_frames);
+                          } else
+                              l_success = false;
+                          l_frame_index += l_block_frames;
+                      }
+                      if(file_write_head(true) == false) {
+                          l_success = false;
+                      }
+                      file_close();
+                  }
+              }
+          }
+      }
+      return l_success;
+}
+
+std::uint64_t bounce::get_frame_count() const noexcept
+{
+      return m_frame_count;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,75 @@
+#ifndef dsp_bounce_h
+#define dsp_bounce_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "config.h"
+#include <cstdio>
+#include <cstdint>
+
+namespace dsp {
+
+/* bounce
+   offline renderer: drives an apu faster than real time, in large blocks, and streams the result into a raw or a WAV file;
+   the WAV header is promoted to RF64 once the data outgrows the 4GiB RIFF limit
+*/
+class bounce
+{
+  apu*          m_apu;
+  std::FILE*    m_file;
+  char*         m_file_buffer;
+  fptype*       m_block_ptr;
+  int           m_block_frames;
+  unsigned int  m_file_format;
+  int           m_sample_size;
+  std::uint64_t m_frame_count;
+
+  private:
+          bool  file_open(const char*) noexcept;
+          bool  file_write_head(bool) noexcept;
+          bool  file_write_data(int) noexcept;
+          void  file_close() noexcept;
+
+  public:
+  /* ff_*
+     file formats
+  */
+  static constexpr unsigned int ff_raw = 0u;              // headerless, native fptype samples
+  static constexpr unsigned int ff_wave = 1u;             // WAV/RF64, IEEE float samples
+
+  public:
+          bounce(apu*) noexcept;
+          bounce(apu*, unsigned int, int = bounce_block_frames) noexcept;
+          bounce(const bounce&) noexcept = delete;
+          bounce(bounce&&) noexcept = delete;
+          ~bounce();
+
+          bool  run(const char*, float) noexcept;
+
+          std::uint64_t get_frame_count() const noexcept;
+
+          bounce& operator=(const bounce&) noexcept = delete;
+          bounce& operator=(bounce&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
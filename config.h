@@ -42,6 +42,11 @@ constexpr int  memory_register_page = 16;
 */
 constexpr int  memory_instruction_page = 64;
 
+/* memory_code_page
+ * size of the pages the mmu carves the compiled storage of cores (arguments, data registers, instructions) from
+*/
+constexpr int  memory_code_page = 65536;
+
 /* memory_vector_block
 */
 constexpr int  memory_vector_block = 64;
@@ -56,6 +61,77 @@ constexpr int  memory_vector_page = 131072;
 static_assert((memory_vector_page % memory_vector_block) == 0, "vector page size must be a multiple of memory_vector_block");
 static_assert(memory_vector_page > memory_vector_block * 2, "vector page size must be at least twice the size of memory_vector_block");
 
+/* memory_line_size
+ * cache line size; counters shared between threads are aligned to it in order to avoid false sharing
+*/
+constexpr int  memory_line_size = 64;
+
+/* bounce_block_frames
+ * default number of frames the offline renderer renders in a single pass
+*/
+constexpr int  bounce_block_frames = 8192;
+
+/* bounce_file_buffer
+ * size of the write buffer of the offline renderer, in bytes
+*/
+constexpr int  bounce_file_buffer = 1048576;
+
+/* reader_prefetch_size
+ * how far ahead of the play position a file reader asks the kernel to page in, in bytes
+*/
+constexpr int  reader_prefetch_size = 4194304;
+
+/* player_head_frames
+ * default number of frames at the start of a sample a streaming player keeps resident
+*/
+constexpr int  player_head_frames = 32768;
+
+/* player_stream_frames
+ * default capacity of the stream ring of a streaming player voice, in frames
+*/
+constexpr int  player_stream_frames = 32768;
+
+/* streamer_block_frames
+ * number of frames the streaming thread decodes into a voice ring in one go
+*/
+constexpr int  streamer_block_frames = 4096;
+
+/* stft_frame_size
+ * default frame size of the short-time fourier transform nodes, in samples; frames overlap by half
+*/
+constexpr int  stft_frame_size = 1024;
+
+/* convolver_block_size
+ * default partition size of the convolver, in samples; also the length of its direct form head
+*/
+constexpr int  convolver_block_size = 128;
+
+/* resampler_taps
+ * length of the interpolation kernel of the sample rate converters; when decimating the kernel is stretched by the rate ratio
+*/
+constexpr int  resampler_taps = 32;
+
+/* resampler_phases
+ * number of fractional positions the resampler kernel is tabulated at; positions in between are interpolated linearly
+*/
+constexpr int  resampler_phases = 64;
+
+/* resampler_block_frames
+ * number of input frames a resampler takes into its history at once; longer inputs are consumed in runs of this size, such
+ * that the history is sized once, when the converter is set up, and never grows on the render thread
+*/
+constexpr int  resampler_block_frames = 256;
+
+/* oversampler_kernel_size
+ * number of non-zero taps on either side of the centre tap of the half-band decimation kernels of the oversampler
+*/
+constexpr int  oversampler_kernel_size = 12;
+
+/* wavetable_size
+ * number of samples in one cycle of each level of a wavetable; also bounds the number of harmonics to half as many
+*/
+constexpr int  wavetable_size = 2048;
+
 /* default sample rate
  * default sample rate to initialize atoms with
 */
@@ -22,144 +22,4 @@
 #include "constant.h"
 
 namespace dsp {
-
-      constant::constant() noexcept:
-      m_value(0.0f)
-{
-}
-
-      constant::constant(fptype value) noexcept:
-      m_value(value)
-{
-}
-
-      constant::constant(const constant& copy) noexcept:
-      m_value(copy.m_value)
-{
-}
-
-      constant::constant(constant&& copy) noexcept:
-      m_value(copy.m_value)
-{
-}
-
-      constant::~constant()
-{
-}
-
-fptype constant::get_value() const noexcept
-{
-      return m_value;
-}
-
-constant  constant::operator+(const constant& rhs) noexcept
-{
-      return constant(m_value + rhs.m_value);
-}
-
-constant  constant::operator-(const constant& rhs) noexcept
-{
-      return constant(m_value - rhs.m_value);
-}
-
-constant  constant::operator*(const constant& rhs) noexcept
-{
-      return constant(m_value * rhs.m_value);
-}
-
-constant  constant::operator/(const constant& rhs) noexcept
-{
-      return constant(m_value / rhs.m_value);
-}
-
-constant& constant::operator+=(const constant& rhs) noexcept
-{
-      m_value += rhs.m_value;
-      return *this;
-}
-
-constant& constant::operator-=(const constant& rhs) noexcept
-{
-      m_value -= rhs.m_value;
-      return *this;
-}
-
-constant& constant::operator*=(const constant& rhs) noexcept
-{
-      m_value *= rhs.m_value;
-      return *this;
-}
-
-constant& constant::operator/=(const constant& rhs) noexcept
-{
-      m_value *= rhs.m_value;
-      return *this;
-}
-
-bool  constant::operator<(const constant& rhs) noexcept
-{
-      return m_value < rhs.m_value;
-}
-
-bool  constant::operator<=(const constant& rhs) noexcept
-{
-      return m_value <= rhs.m_value;
-}
-
-bool  constant::operator>(const constant& rhs) noexcept
-{
-      return m_value > rhs.m_value;
-}
-
-bool  constant::operator>=(const constant& rhs) noexcept
-{
-      return m_value >= rhs.m_value;
-}
-
-bool  constant::operator==(const constant& rhs) noexcept
-{
-      return m_value == rhs.m_value;
-}
-
-bool  constant::operator!=(const constant& rhs) noexcept
-{
-      return m_value != rhs.m_value;
-}
-
-int   constant::operator<=>(const constant& rhs) noexcept
-{
-      return static_cast<int>(m_value - rhs.m_value);
-}
-
-      constant::operator fptype() const noexcept
-{
-      return get_value();
-}
-
-constant& constant::swap(constant& rhs) noexcept
-{
-      if(std::addressof(rhs) != this) {
-          fptype l_lhs = rhs.m_value;
-          rhs.m_value = m_value;
-          m_value = l_lhs;
-      }
-      return *this;
-}
-
-constant& constant::operator=(const constant& rhs) noexcept
-{
-      if(std::addressof(rhs) != this) {
-          m_value = rhs.m_value;
-      }
-      return *this;
-}
-
-constant& constant::operator=(constant&& rhs) noexcept
-{
-      if(std::addressof(rhs) != this) {
-          m_value = rhs.m_value;
-      }
-      return *this;
-}
-
 /*namespace dsp*/ }
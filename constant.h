@@ -26,6 +26,10 @@
 
 namespace dsp {
 
+/* constant
+   literal leaf of a lattice expression; all members are constexpr so that expressions made only of constants fold into a
+   single constant at compile time, see the constant overloads in factory.h
+*/
 class constant: public symbol
 {
   fptype  m_value;
@@ -36,38 +40,101 @@ class constant: public symbol
   static constexpr int used_instruction_count = 1;
   
   public:
-          constant() noexcept;
-          constant(fptype) noexcept;
-          constant(const constant&) noexcept;
-          constant(constant&&) noexcept;
-          ~constant();
-
-          fptype    get_value() const noexcept;
-          
-          constant  operator+(const constant&) noexcept;
-          constant  operator-(const constant&) noexcept;
-          constant  operator*(const constant&) noexcept;
-          constant  operator/(const constant&) noexcept;
-
-          constant& operator+=(const constant&) noexcept;
-          constant& operator-=(const constant&) noexcept;
-          constant& operator*=(const constant&) noexcept;
-          constant& operator/=(const constant&) noexcept;
-
-          bool      operator<(const constant&) noexcept;
-          bool      operator<=(const constant&) noexcept;
-          bool      operator>(const constant&) noexcept;
-          bool      operator>=(const constant&) noexcept;
-          bool      operator==(const constant&) noexcept;
-          bool      operator!=(const constant&) noexcept;
-          int       operator<=>(const constant&) noexcept;
-
-          operator  fptype() const noexcept;
-          
-          constant& swap(constant&) noexcept;
-
-          constant& operator=(const constant&) noexcept;
-          constant& operator=(constant&&) noexcept;
+  constexpr constant() noexcept:
+            m_value(0.0f) {
+  }
+
+  constexpr constant(fptype value) noexcept:
+            m_value(value) {
+  }
+
+  constexpr constant(const constant&) noexcept = default;
+  constexpr constant(constant&&) noexcept = default;
+  constexpr ~constant() = default;
+
+  constexpr fptype get_value() const noexcept {
+          return m_value;
+  }
+
+  constexpr constant operator+(const constant& rhs) const noexcept {
+          return constant(m_value + rhs.m_value);
+  }
+
+  constexpr constant operator-(const constant& rhs) const noexcept {
+          return constant(m_value - rhs.m_value);
+  }
+
+  constexpr constant operator*(const constant& rhs) const noexcept {
+          return constant(m_value * rhs.m_value);
+  }
+
+  constexpr constant operator/(const constant& rhs) const noexcept {
+          return constant(m_value / rhs.m_value);
+  }
+
+  constexpr constant& operator+=(const constant& rhs) noexcept {
+          m_value += rhs.m_value;
+          return *this;
+  }
+
+  constexpr constant& operator-=(const constant& rhs) noexcept {
+          m_value -= rhs.m_value;
+          return *this;
+  }
+
+  constexpr constant& operator*=(const constant& rhs) noexcept {
+          m_value *= rhs.m_value;
+          return *this;
+  }
+
+  constexpr constant& operator/=(const constant& rhs) noexcept {
+          m_value /= rhs.m_value;
+          return *this;
+  }
+
+  constexpr bool operator<(const constant& rhs) const noexcept {
+          return m_value < rhs.m_value;
+  }
+
+  constexpr bool operator<=(const constant& rhs) const noexcept {
+          return m_value <= rhs.m_value;
+  }
+
+  constexpr bool operator>(const constant& rhs) const noexcept {
+          return m_value > rhs.m_value;
+  }
+
+  constexpr bool operator>=(const constant& rhs) const noexcept {
+          return m_value >= rhs.m_value;
+  }
+
+  constexpr bool operator==(const constant& rhs) const noexcept {
+          return m_value == rhs.m_value;
+  }
+
+  constexpr bool operator!=(const constant& rhs) const noexcept {
+          return m_value != rhs.m_value;
+  }
+
+  constexpr int operator<=>(const constant& rhs) const noexcept {
+          return static_cast<int>(m_value - rhs.m_value);
+  }
+
+  constexpr operator fptype() const noexcept {
+          return m_value;
+  }
+
+  constexpr constant& swap(constant& rhs) noexcept {
+          if(std::addressof(rhs) != this) {
+              fptype l_lhs = rhs.m_value;
+              rhs.m_value = m_value;
+              m_value = l_lhs;
+          }
+          return *this;
+  }
+
+  constexpr constant& operator=(const constant&) noexcept = default;
+  constexpr constant& operator=(constant&&) noexcept = default;
 };
 
 /*namespace dsp*/ }
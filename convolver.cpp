@@ -0,0 +1,220 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "convolver.h"
+
+namespace dsp {
+
+      convolver::convolver() noexcept:
+      convolver(convolver_block_size)
+{
+}
+
+      convolver::convolver(int block) noexcept:
+      core(o_none),
+      m_input(this),
+      m_fft(block * 2),
+      m_block(block),
+      m_length(0),
+      m_partition_count(0),
+      m_position(0),
+      m_fdl_index(0),
+      m_data(nullptr)
+{
+      set_sample_format(fmt_pcm_1);
+}
+
+      convolver::~convolver()
+{
+      dispose();
+}
+
+/* dsp_convolve()
+   push the input block that was just completed onto the delay line and compute the tail output for the next block
+*/
+void  convolver::dsp_convolve() noexcept
+{
+      int l_bins = m_block + 1;
+      fptype* l_fdl_re = m_fdl_re + m_fdl_index * l_bins;
+      fptype* l_fdl_im = m_fdl_im + m_fdl_index * l_bins;
+      m_fft.forward(m_frame, l_fdl_re, l_fdl_im);
+      pcm_clr(m_acc_re, l_bins);
+      pcm_clr(m_acc_im, l_bins);
+      for(int i_partition = 0; i_partition < m_partition_count; i_partition++) {
+          int l_slot = m_fdl_index - i_partition;
+          if(l_slot < 0) {
+              l_slot += m_partition_count;
+          }
+          const fptype* l_x_re = m_fdl_re + l_slot * l_bins;
+          const fptype* l_x_im = m_fdl_im + l_slot * l_bins;
+          const fptype* l_h_re = m_ir_re + i_partition * l_bins;
+          const fptype* l_h_im = m_ir_im + i_partition * l_bins;
+          for(int i_bin = 0; i_bin < l_bins; i_bin++) {
+              m_acc_re[i_bin] += l_x_re[i_bin] * l_h_re[i_bin] - l_x_im[i_bin] * l_h_im[i_bin];
+              m_acc_im[i_bin] += l_x_re[i_bin] * l_h_im[i_bin] + l_x_im[i_bin] * l_h_re[i_bin];
+          }
+      }
+      // overlap-save: the second half of the circular result is the linear one, the first half wraps around
+      m_fft.inverse(m_acc_re, m_acc_im, m_result);
+      pcm_mov(m_output, m_result + m_block, m_block);
+      if(++m_fdl_index == m_partition_count) {
+          m_fdl_index = 0;
+      }
+}
+
+bool  convolver::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      fptype* l_input_ptr = m_input.get_return_vector();
+      fptype* l_output_ptr = dsp_get_return_vector();
+      if(m_data == nullptr) {
+          if((op & op_render_additive) == 0) {
+              pcm_clr(l_output_ptr, l_frames);
+          }
+          return true;
+      }
+      for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+          fptype  l_input = l_input_ptr != nullptr ? l_input_ptr[i_frame] : 0.0f;
+          fptype  l_output = m_output[m_position];
+          fptype* l_history_ptr;
+          // direct form head over the last `block` samples, oldest first
+          m_history[m_position] = l_input;
+          m_history[m_position + m_block] = l_input;
+          l_history_ptr = m_history + m_position + 1;
+          for(int i_tap = 0; i_tap < m_block; i_tap++) {
+              l_output += m_head[i_tap] * l_history_ptr[i_tap];
+          }
+          if(op & op_render_additive) {
+              l_output_ptr[i_frame] += l_output;
+          } else
+              l_output_ptr[i_frame] = l_output;
+          m_frame[m_block + m_position] = l_input;
+          if(++m_position == m_block) {
+              if(m_partition_count > 0) {
+                  dsp_convolve();
+                  pcm_mov(m_frame, m_frame + m_block, m_block);
+              }
+              m_position = 0;
+          }
+      }
+      return true;
+}
+
+/* load()
+   set up the convolution for the given impulse response; computes the partition spectra, so it is meant to be called
+   outside of the render thread, while the node is not being rendered
+*/
+bool  convolver::load(const fptype* ir, int length) noexcept
+{
+      int  l_partition_count;
+      int  l_bins = m_block + 1;
+      int  l_size;
+      if(m_fft.is_valid() == false) {
+          return false;
+      }
+      if((ir == nullptr) ||
+          (length <= 0)) {
+          return false;
+      }
+      l_partition_count = length > m_block ? (length - 1) / m_block : 0;
+      l_size = m_block * 9 + l_bins * (l_partition_count * 4 + 2);
+      auto l_data = reinterpret_cast<fptype*>(malloc(l_size * sizeof(fptype)));
+      if(l_data == nullptr) {
+          return false;
+      }
+      dispose();
+      m_data = l_data;
+      m_head = m_data;
+      m_history = m_head + m_block;
+      m_frame = m_history + m_block * 2;
+      m_result = m_frame + m_block * 2;
+      m_output = m_result + m_block * 2;
+      m_acc_re = m_output + m_block;
+      m_acc_im = m_acc_re + l_bins;
+      m_ir_re = m_acc_im + l_bins;
+      m_ir_im = m_ir_re + l_bins * l_partition_count;
+      m_fdl_re = m_ir_im + l_bins * l_partition_count;
+      m_fdl_im = m_fdl_re + l_bins * l_partition_count;
+      m_length = length;
+      m_partition_count = l_partition_count;
+      for(int i_tap = 0; i_tap < m_block; i_tap++) {
+          m_head[m_block - 1 - i_tap] = i_tap < length ? ir[i_tap] : 0.0f;
+      }
+      for(int i_partition = 0; i_partition < l_partition_count; i_partition++) {
+          int l_base = m_block * (i_partition + 1);
+          pcm_clr(m_frame, m_block * 2);
+          for(int i_tap = 0; (i_tap < m_block) && (l_base + i_tap < length); i_tap++) {
+              m_frame[i_tap] = ir[l_base + i_tap];
+          }
+          m_fft.forward(m_frame, m_ir_re + i_partition * l_bins, m_ir_im + i_partition * l_bins);
+      }
+      reset();
+      return true;
+}
+
+/* reset()
+   silence the convolution state, keep the impulse response
+*/
+void  convolver::reset() noexcept
+{
+      if(m_data != nullptr) {
+          int l_bins = m_block + 1;
+          pcm_clr(m_history, m_block * 2);
+          pcm_clr(m_frame, m_block * 2);
+          pcm_clr(m_output, m_block);
+          pcm_clr(m_fdl_re, l_bins * m_partition_count);
+          pcm_clr(m_fdl_im, l_bins * m_partition_count);
+      }
+      m_position = 0;
+      m_fdl_index = 0;
+}
+
+void  convolver::dispose() noexcept
+{
+      if(m_data != nullptr) {
+          free(m_data);
+          m_data = nullptr;
+          m_length = 0;
+          m_partition_count = 0;
+      }
+}
+
+gate& convolver::get_input() noexcept
+{
+      return m_input;
+}
+
+int   convolver::get_block_size() const noexcept
+{
+      return m_block;
+}
+
+int   convolver::get_length() const noexcept
+{
+      return m_length;
+}
+
+bool  convolver::is_valid() const noexcept
+{
+      return m_data != nullptr;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,83 @@
+#ifndef dsp_convolver_h
+#define dsp_convolver_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include "fft.h"
+
+namespace dsp {
+
+/* convolver
+   zero latency convolution of a mono input with an impulse response of any length: the first `block` taps are applied
+   in direct form, sample by sample, while the rest of the response is split into `block` sized partitions that are
+   applied in the frequency domain, uniformly partitioned overlap-save fashion, through a frequency domain delay line;
+   the output of a partitioned block lands exactly where the direct form head leaves off
+*/
+class convolver: public core
+{
+  gate      m_input;
+  fft       m_fft;
+  int       m_block;
+  int       m_length;
+  int       m_partition_count;
+  int       m_position;
+  int       m_fdl_index;
+  fptype*   m_data;
+  fptype*   m_head;           // direct form taps, reversed
+  fptype*   m_history;        // last `block` input samples, stored twice so that the head sees them contiguously
+  fptype*   m_frame;          // previous and current input block
+  fptype*   m_result;
+  fptype*   m_output;         // tail output for the current block
+  fptype*   m_acc_re;
+  fptype*   m_acc_im;
+  fptype*   m_ir_re;          // spectra of the tail partitions
+  fptype*   m_ir_im;
+  fptype*   m_fdl_re;         // spectra of the past input blocks
+  fptype*   m_fdl_im;
+
+  protected:
+          void    dsp_convolve() noexcept;
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          convolver() noexcept;
+          convolver(int) noexcept;
+          convolver(const convolver&) noexcept = delete;
+          convolver(convolver&&) noexcept = delete;
+  virtual ~convolver();
+
+          bool    load(const fptype*, int) noexcept;
+          void    reset() noexcept;
+          void    dispose() noexcept;
+
+          gate&   get_input() noexcept;
+          int     get_block_size() const noexcept;
+          int     get_length() const noexcept;
+          bool    is_valid() const noexcept;
+
+          convolver& operator=(const convolver&) noexcept = delete;
+          convolver& operator=(convolver&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
@@ -21,6 +21,12 @@
 **/
 #include "core.h"
 #include "apu.h"
+#include "image.h"
+#include "mmu.h"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace dsp {
 
@@ -31,6 +37,7 @@ namespace dsp {
       m_source(nullptr),
       m_gate_next(nullptr),
       m_value_ptr(nullptr),
+      m_resampler(nullptr),
       m_enable_bit(false)
 {
       if(owner != nullptr) {
@@ -43,6 +50,10 @@ namespace dsp {
       if(m_owner != nullptr) {
           m_owner->drop(this);
       }
+      if(m_resampler != nullptr) {
+          m_resampler->~resampler();
+          free(m_resampler);
+      }
 }
 
 void  gate::bind(fptype* address) noexcept
@@ -69,6 +80,8 @@ bool  gate::attach(core* source_ptr) noexcept
           }
           if(m_owner->join(source_ptr, this)) {
               m_source = source_ptr;
+              // a failure to set up the converter here isn't fatal, the render retries it
+              make_resampler();
               return  true;
           }
       }
@@ -92,6 +105,55 @@ bool  gate::detach() noexcept
       return false;
 }
 
+/* make_resampler()
+   set up the rate converter of the gate for the given rates and channel count; it's only ever rebuilt when either of them
+   changes
+*/
+bool  gate::make_resampler(int rate_in, int rate_out, int channels) noexcept
+{
+      resampler* p_resampler = m_resampler;
+      if(p_resampler == nullptr) {
+          p_resampler = reinterpret_cast<resampler*>(malloc(sizeof(resampler)));
+          if(p_resampler == nullptr) {
+              return false;
+          }
+          m_resampler = new(p_resampler) resampler;
+      }
+      if((p_resampler->get_rate_in() != rate_in) ||
+          (p_resampler->get_rate_out() != rate_out) ||
+          (p_resampler->get_channel_count() != channels)) {
+          return p_resampler->reset(rate_in, rate_out, channels);
+      }
+      return true;
+}
+
+/* make_resampler()
+   set up the rate converter of the gate ahead of the render, if its source renders at a rate of its own, going by the rate
+   and the input format the owner is set up with; the render only has to rebuild it if the owner ends up on a branch that
+   runs at another rate
+*/
+bool  gate::make_resampler() noexcept
+{
+      if((m_owner != nullptr) &&
+          (m_source != nullptr)) {
+          int  l_rate_in = m_source->m_sample_rate;
+          int  l_rate_out = m_owner->get_sample_rate() * m_owner->m_input_factor;
+          if((l_rate_in != 0) &&
+              (l_rate_out != 0) &&
+              (l_rate_in != l_rate_out)) {
+              unsigned int l_format = m_source->m_sample_format;
+              if(l_format == fmt_undef) {
+                  l_format = m_owner->get_input_format();
+              }
+              if((l_format != fmt_undef) &&
+                  (fmt_get_mode(l_format) == mode_pcm)) {
+                  return make_resampler(l_rate_in, l_rate_out, fmt_get_sample_size(l_format));
+              }
+          }
+      }
+      return true;
+}
+
 fptype* gate::get_return_vector() const noexcept
 {
       return m_value_ptr;
@@ -124,6 +186,7 @@ bool  gate::is_detached() const noexcept
       m_core_next(nullptr),
       m_gate_head(nullptr),
       m_gate_tail(nullptr),
+      m_s_base(nullptr),
       m_d_base(nullptr),
       m_i_base(nullptr),
       m_d_size(0),
@@ -134,10 +197,15 @@ bool  gate::is_detached() const noexcept
       m_argv(nullptr),
       m_argc(0),
       m_variable_count(0),
+      m_uniform_count(0),
       m_register_count(0),
       m_instruction_count(0),
       m_option(option),
-      m_hash(0)
+      m_hash(0),
+      m_sample_format(fmt_undef),
+      m_input_format(fmt_undef),
+      m_sample_rate(0),
+      m_input_factor(1)
 {
 }
 
@@ -221,6 +289,18 @@ bool  core::can_join(core* core_ptr) noexcept
       return true;
 }
 
+/* make_resamplers()
+   set up the rate converters of the gates of the node ahead of the render, after a change to the rate of its inputs
+*/
+void  core::make_resamplers() noexcept
+{
+      gate* i_gate = m_gate_head;
+      while(i_gate != nullptr) {
+          i_gate->make_resampler();
+          i_gate = i_gate->m_gate_next;
+      }
+}
+
 bool  core::part(core* core_ptr, gate* gate_ptr) noexcept
 {
       bool l_allow_part = (m_option & o_enable_part_event) ? part_event(gate_ptr, core_ptr) : true;
@@ -236,6 +316,7 @@ void  core::move(core& rhs) noexcept
 {
       if(std::addressof(rhs) != this) {
           dispose();
+          m_s_base = rhs.m_s_base;
           m_d_base = rhs.m_d_base;
           m_i_base = rhs.m_i_base;
           m_d_size = rhs.m_d_size;
@@ -244,38 +325,303 @@ void  core::move(core& rhs) noexcept
           m_argc = rhs.m_argc;
           m_arg_size = rhs.m_arg_size;
           m_variable_count = rhs.m_variable_count;
+          m_uniform_count = rhs.m_uniform_count;
           m_register_count = rhs.m_register_count;
           m_instruction_count = rhs.m_instruction_count;
+          m_sample_format = rhs.m_sample_format;
+          m_input_format = rhs.m_input_format;
+          m_sample_rate = rhs.m_sample_rate;
+          m_input_factor = rhs.m_input_factor;
           rhs.release();
       }
 }
 
 void  core::release() noexcept
 {
+      m_s_base = nullptr;
       m_d_base = nullptr;
       m_i_base = nullptr;
       m_argc   = 0;
       m_argv   = nullptr;
 }
 
+/* make_storage()
+   allocate the compiled storage of the core - data registers, instructions and arguments, given by their sizes in bytes -
+   as a single block: from the mmu active on the calling thread if there is one, from the heap otherwise
+*/
+bool  core::make_storage(int d_size, int i_size, int arg_size) noexcept
+{
+      constexpr std::size_t l_align =
+          fpu::pts * sizeof(fptype) > alignof(std::max_align_t) ? fpu::pts * sizeof(fptype) : alignof(std::max_align_t);
+      std::size_t l_d_offset = 0;
+      std::size_t l_i_offset = get_round_value<std::size_t>(l_d_offset + d_size, l_align);
+      std::size_t l_arg_offset = get_round_value<std::size_t>(l_i_offset + i_size, l_align);
+      std::size_t l_size = l_arg_offset + arg_size;
+      std::uint8_t* l_base;
+      if((d_size > std::numeric_limits<short int>::max()) ||
+          (i_size > std::numeric_limits<short int>::max()) ||
+          (arg_size > std::numeric_limits<short int>::max())) {
+          return false;
+      }
+      dispose();
+      if(mmu* l_mmu = mmu::get_current(); l_mmu != nullptr) {
+          l_base = reinterpret_cast<std::uint8_t*>(l_mmu->acquire(l_size, l_align));
+      } else
+      if(l_base = reinterpret_cast<std::uint8_t*>(std::aligned_alloc(l_align, get_round_value(l_size, l_align))); l_base != nullptr) {
+          m_s_base = l_base;
+      }
+      if(l_base == nullptr) {
+          return false;
+      }
+      m_d_base = d_size > 0 ? reinterpret_cast<fptype*>(l_base + l_d_offset) : nullptr;
+      m_i_base = i_size > 0 ? reinterpret_cast<micro*>(l_base + l_i_offset) : nullptr;
+      m_argv = arg_size > 0 ? reinterpret_cast<argument*>(l_base + l_arg_offset) : nullptr;
+      m_d_size = d_size;
+      m_i_size = i_size;
+      m_arg_size = arg_size;
+      return true;
+}
+
+/* dispose()
+   release the compiled storage of the core; storage that belongs to an mmu is left alone, as the mmu may already have
+   released it along with the rest of the graph
+*/
 void  core::dispose() noexcept
 {
       if(m_argv != nullptr) {
-          while(m_argc >= 0) {
-              --m_argc;
-              m_argv[m_argc].~argument();
+          if(m_s_base != nullptr) {
+              while(m_argc > 0) {
+                  --m_argc;
+                  m_argv[m_argc].~argument();
+              }
           }
-          free(m_argv);
           m_argv = nullptr;
+          m_argc = 0;
+      }
+      if(m_s_base != nullptr) {
+          free(m_s_base);
+          m_s_base = nullptr;
+      }
+      m_i_base = nullptr;
+      m_d_base = nullptr;
+}
+
+/* get_code_size()
+   number of instructions spanned by the arguments of a core
+*/
+static int get_code_size(const micro* i_base, const argument* argv, int argc) noexcept
+{
+      int l_code_size = 0;
+      for(int i_arg = 0; i_arg < argc; i_arg++) {
+          micro* l_code_head;
+          micro* l_code_tail;
+          argv[i_arg].load(l_code_head, l_code_tail);
+          if(l_code_tail - i_base > l_code_size) {
+              l_code_size = l_code_tail - i_base;
+          }
+      }
+      return l_code_size;
+}
+
+/* get_image_size()
+   size of the program image of this core, see image.h; 0 if the core holds no compiled microcode
+*/
+int   core::get_image_size() const noexcept
+{
+      if(m_i_base != nullptr) {
+          return sizeof(img_head_t) +
+              m_argc * sizeof(img_arg_t) +
+              get_code_size(m_i_base, m_argv, m_argc) * sizeof(img_micro_t) +
+              (m_variable_count - m_uniform_count) * sizeof(fptype);
+      }
+      return 0;
+}
+
+/* save_image()
+   store the compiled microcode of this core into a program image; register and data operands are rewritten as indices,
+   so that the image can be loaded at any address and for any vector width; returns the size of the image or 0 on failure
+*/
+int   core::save_image(std::uint8_t* data, int size) const noexcept
+{
+      int   l_image_size = get_image_size();
+      if((l_image_size == 0) ||
+          (l_image_size > size)) {
+          return 0;
+      }
+      int   l_code_size = get_code_size(m_i_base, m_argv, m_argc);
+      img_head_t l_head;
+      std::uint8_t* p_data = data + sizeof(img_head_t);
+      for(int i_arg = 0; i_arg < m_argc; i_arg++) {
+          micro* l_code_head;
+          micro* l_code_tail;
+          img_arg_t l_arg;
+          m_argv[i_arg].load(l_code_head, l_code_tail);
+          l_arg.code_head = l_code_head - m_i_base;
+          l_arg.code_tail = l_code_tail - m_i_base;
+          std::memcpy(p_data, std::addressof(l_arg), sizeof(l_arg));
+          p_data += sizeof(l_arg);
+      }
+      for(int i_code = 0; i_code < l_code_size; i_code++) {
+          const micro& l_micro = m_i_base[i_code];
+          img_micro_t  l_image;
+          l_image.op_code = l_micro.op_code;
+          l_image.op_dst = l_micro.op_dst;
+          l_image.op_src = l_micro.op_src;
+          l_image.bits =
+              l_micro.bit_flags |
+              (l_micro.bit_const << 4) |
+              (l_micro.bit_volatile << 5) |
+              (l_micro.bit_halt << 6) |
+              (l_micro.bit_return << 7);
+          l_image.dst = 0;
+          l_image.src = 0;
+          l_image.src_a = 0;
+          if(l_micro.op_dst == micro::op_dst_r) {
+              l_image.dst = l_micro.dst.r / fpu::pts;
+          }
+          if(l_micro.op_src == micro::op_src_r) {
+              l_image.src = l_micro.src.r / fpu::pts;
+          } else
+          if(l_micro.op_src == micro::op_src_rr) {
+              l_image.src = l_micro.src.f.r / fpu::pts;
+              l_image.src_a = l_micro.src.f.a / fpu::pts;
+          } else
+          if(l_micro.op_src == micro::op_src_p) {
+              int l_index = (l_micro.src.p - m_d_base) / fpu::pts;
+              if((l_index < 0) ||
+                  (l_index >= m_variable_count)) {
+                  return 0;
+              }
+              l_image.op_src = micro::op_src_d;
+              l_image.src = l_index;
+          }
+          std::memcpy(p_data, std::addressof(l_image), sizeof(l_image));
+          p_data += sizeof(l_image);
+      }
+      for(int i_data = m_uniform_count; i_data < m_variable_count; i_data++) {
+          std::memcpy(p_data, m_d_base + i_data * fpu::pts, sizeof(fptype));
+          p_data += sizeof(fptype);
+      }
+      std::memcpy(l_head.id, "DSPX", 4);
+      l_head.version = img_version;
+      l_head.value_size = sizeof(fptype);
+      l_head.argc = m_argc;
+      l_head.variable_count = m_variable_count;
+      l_head.uniform_count = m_uniform_count;
+      l_head.register_count = m_register_count;
+      l_head.instruction_count = l_code_size;
+      l_head.reserved = 0;
+      l_head.size = l_image_size - sizeof(img_head_t);
+      l_head.hash = img_get_hash(data + sizeof(img_head_t), l_head.size);
+      std::memcpy(data, std::addressof(l_head), sizeof(l_head));
+      return l_image_size;
+}
+
+/* load_image()
+   replace the microcode of this core with the one stored in a program image; the data registers that belong to uniforms
+   are cleared and left for the caller to rebind
+*/
+bool  core::load_image(const std::uint8_t* data, std::uint64_t size) noexcept
+{
+      img_head_t l_head;
+      if(img_is_valid(data, size) == false) {
+          return false;
+      }
+      std::memcpy(std::addressof(l_head), data, sizeof(l_head));
+      if((l_head.argc == 0) ||
+          (l_head.instruction_count == 0)) {
+          return false;
       }
-      if(m_i_base) {
-          free(m_i_base);
-          m_i_base = nullptr;
+      if((l_head.argc * sizeof(argument) > static_cast<std::size_t>(std::numeric_limits<short int>::max())) ||
+          (l_head.variable_count * fpu::pts * sizeof(fptype) > static_cast<std::size_t>(std::numeric_limits<short int>::max())) ||
+          (l_head.instruction_count * sizeof(micro) > static_cast<std::size_t>(std::numeric_limits<short int>::max()))) {
+          return false;
       }
-      if(m_d_base) {
-          free(m_d_base);
-          m_d_base = nullptr;
+      if(make_storage(
+              l_head.variable_count * fpu::pts * sizeof(fptype),
+              l_head.instruction_count * sizeof(micro),
+              l_head.argc * sizeof(argument)) == false) {
+          return false;
+      }
+      m_variable_count = l_head.variable_count;
+      m_uniform_count = l_head.uniform_count;
+      m_register_count = l_head.register_count;
+      m_instruction_count = l_head.instruction_count;
+
+      const std::uint8_t* p_data = data + sizeof(img_head_t);
+      const std::uint8_t* p_code = p_data + l_head.argc * sizeof(img_arg_t);
+      const std::uint8_t* p_value = p_code + l_head.instruction_count * sizeof(img_micro_t);
+      bool  l_result = true;
+      for(int i_code = 0; i_code < l_head.instruction_count; i_code++) {
+          micro&      l_micro = m_i_base[i_code];
+          img_micro_t l_image;
+          std::memcpy(std::addressof(l_image), p_code, sizeof(l_image));
+          p_code += sizeof(l_image);
+          l_micro.op_code = l_image.op_code;
+          l_micro.op_dst = l_image.op_dst;
+          l_micro.op_src = l_image.op_src;
+          l_micro.bit_flags = l_image.bits & 15u;
+          l_micro.bit_const = (l_image.bits >> 4) & 1u;
+          l_micro.bit_volatile = (l_image.bits >> 5) & 1u;
+          l_micro.bit_halt = (l_image.bits >> 6) & 1u;
+          l_micro.bit_return = (l_image.bits >> 7) & 1u;
+          l_micro.dst.r = l_image.dst * fpu::pts;
+          l_micro.src.p = nullptr;
+          if((l_image.dst < 0) ||
+              (l_image.dst >= l_head.register_count)) {
+              l_result = false;
+          }
+          if(l_image.op_src == micro::op_src_r) {
+              l_micro.src.r = l_image.src * fpu::pts;
+              if((l_image.src < 0) ||
+                  (l_image.src >= l_head.register_count)) {
+                  l_result = false;
+              }
+          } else
+          if(l_image.op_src == micro::op_src_rr) {
+              l_micro.src.f.r = l_image.src * fpu::pts;
+              l_micro.src.f.a = l_image.src_a * fpu::pts;
+              if((l_image.src < 0) ||
+                  (l_image.src >= l_head.register_count) ||
+                  (l_image.src_a < 0) ||
+                  (l_image.src_a >= l_head.register_count)) {
+                  l_result = false;
+              }
+          } else
+          if(l_image.op_src == micro::op_src_d) {
+              l_micro.op_src = micro::op_src_p;
+              l_micro.src.p = m_d_base + l_image.src * fpu::pts;
+              if((l_image.src < 0) ||
+                  (l_image.src >= l_head.variable_count)) {
+                  l_result = false;
+              }
+          } else
+          if(l_image.op_src != micro::op_src_no) {
+              l_result = false;
+          }
+      }
+      std::memset(m_d_base, 0, m_d_size);
+      for(int i_data = l_head.uniform_count; i_data < l_head.variable_count; i_data++) {
+          fptype l_value;
+          std::memcpy(std::addressof(l_value), p_value, sizeof(fptype));
+          p_value += sizeof(fptype);
+          fpu::reg_mov(m_d_base + i_data * fpu::pts, l_value);
+      }
+      for(int i_arg = 0; i_arg < l_head.argc; i_arg++) {
+          img_arg_t l_arg;
+          std::memcpy(std::addressof(l_arg), p_data, sizeof(l_arg));
+          p_data += sizeof(l_arg);
+          if((l_arg.code_head > l_arg.code_tail) ||
+              (l_arg.code_tail > l_head.instruction_count)) {
+              l_result = false;
+          }
+          new(m_argv + i_arg) argument(m_i_base + l_arg.code_head, m_i_base + l_arg.code_tail);
+          m_argc = i_arg + 1;
+      }
+      if(l_result == false) {
+          dispose();
       }
+      return l_result;
 }
 
 bool  core::join_event(gate*, core*) noexcept
@@ -342,24 +688,105 @@ bool  core::detach(core* core_ptr, bool drop_all) noexcept
       return (l_core_dropped > 0) && (l_core_dropped == l_core_found);
 }
 
+/* get_sample_format()
+   format the node renders in: its own, if it was given one, otherwise the format of the apu it is attached to (the actual
+   format of an inheriting node is that of the branch it is reached from)
+*/
 unsigned int core::get_sample_format() const noexcept
 {
-      return m_target->get_sample_format();
+      if(m_sample_format != fmt_undef) {
+          return m_sample_format;
+      }
+      if(m_target != nullptr) {
+          return m_target->get_sample_format();
+      }
+      return fmt_undef;
 }
 
+/* set_sample_format()
+   have the node render in the given format, or inherit it from the calling branch if `fmt_undef`; results are converted to
+   the format of the consuming nodes at the gate
+*/
 bool  core::set_sample_format(unsigned int value) noexcept
 {
-      return value == m_target->get_sample_format();
+      if((value == fmt_undef) ||
+          fmt_is_valid(value)) {
+          m_sample_format = value;
+          return true;
+      }
+      return false;
+}
+
+unsigned int core::get_input_format() const noexcept
+{
+      if(m_input_format != fmt_undef) {
+          return m_input_format;
+      }
+      return get_sample_format();
+}
+
+/* set_input_format()
+   have the inputs of the node rendered in the given format, or in the format of the node itself if `fmt_undef`; this is
+   what lets a node convert between formats, e.g. from PCM to amplitude/phase
+*/
+bool  core::set_input_format(unsigned int value) noexcept
+{
+      if((value == fmt_undef) ||
+          fmt_is_valid(value)) {
+          m_input_format = value;
+          return true;
+      }
+      return false;
+}
+
+int   core::get_input_factor() const noexcept
+{
+      return m_input_factor;
+}
+
+/* set_input_factor()
+   have the inputs of the node rendered at `value` times the rate of the node itself, with `value` frames coming in for
+   each frame going out; this is what lets a node run a subtree oversampled
+*/
+bool  core::set_input_factor(int value) noexcept
+{
+      if(value > 0) {
+          m_input_factor = value;
+          make_resamplers();
+          return true;
+      }
+      return false;
 }
 
+/* get_sample_rate()
+   rate the node renders at: its own, if it was given one, otherwise the rate of the apu it is attached to (the actual rate
+   of an inheriting node is that of the branch it is reached from)
+*/
 int   core::get_sample_rate() const noexcept
 {
-      return m_target->get_sample_rate();
+      if(m_sample_rate != 0) {
+          return m_sample_rate;
+      }
+      if(m_target != nullptr) {
+          return m_target->get_sample_rate();
+      }
+      return 0;
 }
 
+/* set_sample_rate()
+   have the node render at the given rate, or inherit it from the calling branch if 0; results are resampled to the rate of
+   the consuming nodes at the gate, such that e.g. control signals can be computed at a fraction of the audio rate; the rate
+   of a node attached directly to an apu is that of the apu
+*/
 bool  core::set_sample_rate(int value) noexcept
 {
-      return value == m_target->get_sample_rate();
+      if((value == 0) ||
+          ((value >= min_sample_rate) && (value <= max_sample_rate))) {
+          m_sample_rate = value;
+          make_resamplers();
+          return true;
+      }
+      return false;
 }
 
 #ifdef DEBUG
@@ -484,6 +911,57 @@ void  core::dump_code(FILE* file, int column_count, int column_width) noexcept
                                   case micro::op_code_div:
                                       std::strncpy(l_i_op, "div", sizeof(l_i_op));
                                       break;
+                                  case micro::op_code_abs:
+                                      std::strncpy(l_i_op, "abs", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_sqrt:
+                                      std::strncpy(l_i_op, "sqrt", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_msk:
+                                      std::strncpy(l_i_op, "msk", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_min:
+                                      std::strncpy(l_i_op, "min", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_max:
+                                      std::strncpy(l_i_op, "max", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_pow:
+                                      std::strncpy(l_i_op, "pow", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_exp:
+                                      std::strncpy(l_i_op, "exp", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_log:
+                                      std::strncpy(l_i_op, "log", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_sin:
+                                      std::strncpy(l_i_op, "sin", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_cos:
+                                      std::strncpy(l_i_op, "cos", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_tanh:
+                                      std::strncpy(l_i_op, "tanh", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_and:
+                                      std::strncpy(l_i_op, "and", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_andn:
+                                      std::strncpy(l_i_op, "andn", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_or:
+                                      std::strncpy(l_i_op, "or", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_fma:
+                                      std::strncpy(l_i_op, "fma", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_fms:
+                                      std::strncpy(l_i_op, "fms", sizeof(l_i_op));
+                                      break;
+                                  case micro::op_code_fnma:
+                                      std::strncpy(l_i_op, "fnma", sizeof(l_i_op));
+                                      break;
                                   case micro::op_code_nop:
                                       std::strncpy(l_i_op, "nop", sizeof(l_i_op));
                                       break;
@@ -512,6 +990,9 @@ void  core::dump_code(FILE* file, int column_count, int column_width) noexcept
                                   case micro::op_src_r:
                                       std::snprintf(l_i_src, sizeof(l_i_src), "r%d", l_code_line->src.r);
                                       break;
+                                  case micro::op_src_rr:
+                                      std::snprintf(l_i_src, sizeof(l_i_src), "r%d r%d", l_code_line->src.f.r, l_code_line->src.f.a);
+                                      break;
                                   case micro::op_src_p:
                                       std::snprintf(l_i_src, sizeof(l_i_src), "%p", l_code_line->src.p);
                                       break;
@@ -28,6 +28,8 @@
 #include "uniform.h"
 #include "argument.h"
 #include "dc.h"
+#include "resampler.h"
+#include <cstdint>
 
 namespace dsp {
 
@@ -37,11 +39,14 @@ class gate
   core*   m_source;             // input node
   gate*   m_gate_next;
   fptype* m_value_ptr;
+  resampler* m_resampler;       // rate converter, for when the source renders at a rate other than the owner's
   bool    m_enable_bit;
 
   protected:
           void   bind(fptype*) noexcept;
           void   unbind() noexcept;
+          bool   make_resampler(int, int, int) noexcept;
+          bool   make_resampler() noexcept;
 
   friend class core;
   friend class apu;
@@ -77,6 +82,7 @@ class core: public dc
   gate*         m_gate_tail;
 
   protected:
+  void*         m_s_base;             // heap block holding the compiled storage below; nullptr if it belongs to an mmu
   fptype*       m_d_base;             // memory for data registers
   micro*        m_i_base;             // memory for the execution stacks
   short int     m_d_size;             // size of the memory region for data registers
@@ -89,10 +95,15 @@ class core: public dc
   short int     m_argc;
   short int     m_arg_size;
   short int     m_variable_count;
+  short int     m_uniform_count;      // leading data registers that are bound to uniforms, the rest hold constants
   short int     m_register_count;
   short int     m_instruction_count;
   short int     m_option;
   unsigned int  m_hash; 
+  unsigned int  m_sample_format;      // format the node renders in; fmt_undef to inherit the format of the calling branch
+  unsigned int  m_input_format;       // format the inputs are rendered in; fmt_undef for the format the node renders in
+  int           m_sample_rate;        // rate the node renders at; 0 to inherit the rate of the calling branch
+  int           m_input_factor;       // rate the inputs are rendered at, as a multiple of the rate the node renders at
 
   friend class  gate;
   friend class  apu;
@@ -103,11 +114,14 @@ class core: public dc
           bool  join(core*, gate*) noexcept;
           bool  can_join(core*) noexcept;
           bool  part(core*, gate*) noexcept;
+          void  make_resamplers() noexcept;
 
   protected:
           void  move(core&) noexcept;
           void  release() noexcept;
+          bool  make_storage(int, int, int) noexcept;
           void  dispose() noexcept;
+          bool  load_image(const std::uint8_t*, std::uint64_t) noexcept;
 
   virtual bool  join_event(gate*, core*) noexcept;
   virtual bool  part_event(gate*, core*) noexcept;
@@ -119,6 +133,7 @@ class core: public dc
   static constexpr short int o_none = 0u;
   static constexpr short int o_enable_join_event = 256;
   static constexpr short int o_enable_part_event = 512;
+  static constexpr short int o_port = 1024;                // node is an external input port, see port.h
 
   public:
           core(unsigned int) noexcept;
@@ -133,9 +148,16 @@ class core: public dc
 
   virtual unsigned int get_sample_format() const noexcept;
   virtual bool  set_sample_format(unsigned int) noexcept;
+          unsigned int get_input_format() const noexcept;
+          bool  set_input_format(unsigned int) noexcept;
+          int   get_input_factor() const noexcept;
+          bool  set_input_factor(int) noexcept;
   virtual int   get_sample_rate() const noexcept;
   virtual bool  set_sample_rate(int) noexcept;
 
+          int   get_image_size() const noexcept;
+          int   save_image(std::uint8_t*, int) const noexcept;
+
           core& operator=(const core&) noexcept = delete;
           core& operator=(core&&) noexcept = delete;
 
@@ -29,7 +29,7 @@ namespace dsp {
 
 static thread_local apu*  s_apu;
 
-      dc::process_base_t* dc::s_process;
+      thread_local dc::process_base_t* dc::s_process;
 
       dc::dc() noexcept
 {
@@ -39,14 +39,60 @@ static thread_local apu*  s_apu;
 {
 }
 
+/* dsp_get_sample_count()
+   number of frames to render on the current branch: `sample_rate * dt` for a branch that runs at a rate of its own, or an
+   exact multiple of the frame count of the branch it was forked from otherwise, such that branches that run at the same
+   (or at a multiple of the same) rate always agree on the frame count
+*/
 int   dc::dsp_get_sample_count() const noexcept
 {
-      return std::roundf(static_cast<float>(dsp_get_sample_rate()) * dsp_get_dt());
+      branch_base_t* p_branch = s_process->branch_tail;
+      int  l_factor = 1;
+      while(p_branch->sample_factor > 0) {
+          l_factor *= p_branch->sample_factor;
+          p_branch = p_branch->branch_parent;
+      }
+      return std::roundf(static_cast<float>(p_branch->sample_rate) * dsp_get_dt()) * l_factor;
 }
 
 int   dc::dsp_get_sample_size() const noexcept
 {
-      return 1 << dsp_get_sample_format(fmt_size_bits);
+      return fmt_get_sample_size(dsp_get_sample_format());
+}
+
+/* dsp_get_channel_stride()
+   distance between the channel runs of a vector in the current format, or 0 if the format is interleaved
+*/
+int   dc::dsp_get_channel_stride() const noexcept
+{
+      return dsp_get_channel_stride(dsp_get_sample_format());
+}
+
+int   dc::dsp_get_channel_stride(unsigned int format) const noexcept
+{
+      if(fmt_is_planar(format)) {
+          return get_round_value(dsp_get_sample_count(), memory_vector_block);
+      }
+      return 0;
+}
+
+/* dsp_get_vector_size()
+   number of values a vector holds in the current format, including the padding between the runs of a planar format
+*/
+int   dc::dsp_get_vector_size() const noexcept
+{
+      return dsp_get_vector_size(dsp_get_sample_format());
+}
+
+int   dc::dsp_get_vector_size(unsigned int format) const noexcept
+{
+      if(format == fmt_undef) {
+          format = dsp_get_sample_format();
+      }
+      if(int l_stride = dsp_get_channel_stride(format); l_stride > 0) {
+          return l_stride * fmt_get_sample_size(format);
+      }
+      return dsp_get_sample_count() * fmt_get_sample_size(format);
 }
 
 fptype*  dc::dsp_get_return_vector() noexcept
@@ -141,6 +187,83 @@ void  dc::pcm_mul(fptype* dp, fptype* sp, int size) noexcept
         }
 }
 
+/* pcm_map_*()
+   strided transfer loops for pcm_map()
+*/
+static void  pcm_map_mov(fptype* dp, int dp_step, fptype* sp, int sp_step, int frames) noexcept
+{
+      for(int i_frame = 0; i_frame < frames; i_frame++) {
+          dp[i_frame * dp_step] = sp[i_frame * sp_step];
+      }
+}
+
+static void  pcm_map_add(fptype* dp, int dp_step, fptype* sp, int sp_step, int frames) noexcept
+{
+      for(int i_frame = 0; i_frame < frames; i_frame++) {
+          dp[i_frame * dp_step] += sp[i_frame * sp_step];
+      }
+}
+
+static void  pcm_map_mov(fptype* dp, int dp_step, fptype* sp, int sp_step, fptype scale, int frames) noexcept
+{
+      for(int i_frame = 0; i_frame < frames; i_frame++) {
+          dp[i_frame * dp_step] = sp[i_frame * sp_step] * scale;
+      }
+}
+
+static void  pcm_map_add(fptype* dp, int dp_step, fptype* sp, int sp_step, fptype scale, int frames) noexcept
+{
+      for(int i_frame = 0; i_frame < frames; i_frame++) {
+          dp[i_frame * dp_step] += sp[i_frame * sp_step] * scale;
+      }
+}
+
+/* pcm_map()
+   transfer `frames` frames between channel counts and layouts; a `stride` of 0 means the channels are interleaved,
+   otherwise it is the distance between the channel runs of a planar vector;
+   channels are spread cyclically when upmixing (mono to all, stereo to front and rear pairs) and folded onto each other
+   and averaged when downmixing; with `additive` the result is added onto the destination
+*/
+void  dc::pcm_map(fptype* dp, int dp_channels, int dp_stride, fptype* sp, int sp_channels, int sp_stride, int frames, bool additive) noexcept
+{
+      int l_dp_step = dp_stride ? 1 : dp_channels;
+      int l_dp_next = dp_stride ? dp_stride : 1;
+      int l_sp_step = sp_stride ? 1 : sp_channels;
+      int l_sp_next = sp_stride ? sp_stride : 1;
+      if((dp_channels == sp_channels) &&
+          (dp_stride == sp_stride)) {
+          // same layout: transfer in one flat pass
+          int l_size = dp_stride ? dp_stride * dp_channels : frames * dp_channels;
+          if(additive) {
+              pcm_add(dp, sp, l_size);
+          } else
+              pcm_mov(dp, sp, l_size);
+      } else
+      if(dp_channels >= sp_channels) {
+          for(int i_channel = 0; i_channel < dp_channels; i_channel++) {
+              fptype* l_dp = dp + i_channel * l_dp_next;
+              fptype* l_sp = sp + (i_channel % sp_channels) * l_sp_next;
+              if(additive) {
+                  pcm_map_add(l_dp, l_dp_step, l_sp, l_sp_step, frames);
+              } else
+                  pcm_map_mov(l_dp, l_dp_step, l_sp, l_sp_step, frames);
+          }
+      } else
+      if(true) {
+          fptype l_scale = static_cast<fptype>(dp_channels) / static_cast<fptype>(sp_channels);
+          for(int i_channel = 0; i_channel < dp_channels; i_channel++) {
+              fptype* l_dp = dp + i_channel * l_dp_next;
+              if(additive == false) {
+                  pcm_map_mov(l_dp, l_dp_step, sp + i_channel * l_sp_next, l_sp_step, l_scale, frames);
+              } else
+                  pcm_map_add(l_dp, l_dp_step, sp + i_channel * l_sp_next, l_sp_step, l_scale, frames);
+              for(int i_fold = i_channel + dp_channels; i_fold < sp_channels; i_fold += dp_channels) {
+                  pcm_map_add(l_dp, l_dp_step, sp + i_fold * l_sp_next, l_sp_step, l_scale, frames);
+              }
+          }
+      }
+}
+
 int   dc::dsp_get_sample_rate() const noexcept
 {
       return s_process->branch_tail->sample_rate;
@@ -63,6 +63,7 @@ class dc
   {
     unsigned int   sample_format;
     int            sample_rate;
+    int            sample_factor;     // frame count as a multiple of that of the parent branch; 0 if it follows from the rate
     int            return_flags;   
     int            return_vector;
     int            vector_assign_lb;
@@ -104,11 +105,15 @@ class dc
   };
 
   private:
-  static  process_base_t* s_process;
+  static  thread_local process_base_t* s_process;
   
   protected:
           int       dsp_get_sample_count() const noexcept;
           int       dsp_get_sample_size() const noexcept;
+          int       dsp_get_channel_stride() const noexcept;
+          int       dsp_get_channel_stride(unsigned int) const noexcept;
+          int       dsp_get_vector_size() const noexcept;
+          int       dsp_get_vector_size(unsigned int) const noexcept;
 
           fptype*   dsp_get_return_vector() noexcept;
           fptype*   dsp_set_return_vector() noexcept;
@@ -121,6 +126,7 @@ class dc
   static  void      pcm_mov(fptype*, fptype*, int) noexcept;  
   static  void      pcm_add(fptype*, fptype*, int) noexcept;
   static  void      pcm_mul(fptype*, fptype*, int) noexcept;
+  static  void      pcm_map(fptype*, int, int, fptype*, int, int, int, bool = false) noexcept;
 
           int      dsp_get_sample_rate() const noexcept;
           unsigned int  dsp_get_sample_format() const noexcept;
@@ -35,6 +35,7 @@ class apu;
 class core;
 class atom;
 class gate;
+class port;
 
 class constant;
 class uniform;
@@ -50,7 +50,7 @@ fptype* factory::d_get_raw(symbol* symbol) noexcept
 
       // get the next unused register within the data pool and save it to the alias pool if
       // a symbol is
-      if(fptype* l_data_ptr = m_d_last; l_data_ptr < m_d_base + m_d_size) {
+      if(fptype* l_data_ptr = m_d_last; l_data_ptr < m_d_base + m_variable_count * fpu::pts) {
           if(symbol != nullptr) {
               m_alias_pool[m_alias_count].reference = symbol;
               m_alias_pool[m_alias_count].address   = l_data_ptr;
@@ -87,56 +87,97 @@ fptype* factory::d_get_variable(uniform& symbol) noexcept
 }
 
 /* r_get_ptr()
-   lookup given register in the live pool
+   lookup given virtual register in the live pool
 */
 factory::reg* factory::r_get_ptr(int rx) noexcept
 {
-      return m_live_pool + (rx / fpu::pts);
+      return m_live_pool + rx;
 }
 
-/* r_get_scratch()
+/* r_get_virtual()
+   reserve a new virtual register for the argument being built
 */
-int   factory::r_get_scratch() noexcept
+int   factory::r_get_virtual() noexcept
 {
-      int  i_register = m_r_last;
-      reg* p_register;
-      // iterate through the m_r_lb..m_r_ub range and check if i_register is in use
-      while(i_register < m_r_ub) {
-          if(p_register = r_get_ptr(i_register); p_register->i_load == nullptr) {
-              break;
-          }
-          m_r_last    = i_register;
-          i_register += fpu::pts;
-      }
-      // found free register, return;
-      if(i_register < m_r_ub) {
-          p_register->i_load  = m_i_last;
-          p_register->b_owner = m_b_tail;
-          return i_register;
+      if(m_live_count < m_variable_count) {
+          reg* p_register = r_get_ptr(m_live_count);
+          p_register->i_last = -1;
+          p_register->r_phys = -1;
+          p_register->i_free = -1;
+          return m_live_count++;
       }
       return -1;
 }
 
-/* r_drop_scratch()
+/* r_allocate()
+   linear scan register allocation over the code of a single argument: compute the live range of every virtual register,
+   then walk the code in order and give each virtual register, where it is first loaded, the lowest physical register whose
+   previous occupant is no longer live; finally rewrite the register operands as offsets into the register table
 */
-void  factory::r_drop_scratch(int rx) noexcept
+bool  factory::r_allocate(micro* code_head, micro* code_tail) noexcept
 {
-      reg* p_register = r_get_ptr(rx);
-      // unset the register in the table
-      if(p_register->i_load) {
-          p_register->i_load  = nullptr;
-          p_register->b_owner = nullptr;
+      int   l_code_size = code_tail - code_head;
+      int   l_phys_count = 0;
+      // live ranges: the last instruction that references each virtual register
+      for(int i_code = 0; i_code < l_code_size; i_code++) {
+          micro& l_micro = code_head[i_code];
+          if(l_micro.op_dst == micro::op_dst_r) {
+              r_get_ptr(l_micro.dst.r)->i_last = i_code;
+          }
+          if(l_micro.op_src == micro::op_src_r) {
+              r_get_ptr(l_micro.src.r)->i_last = i_code;
+          } else
+          if(l_micro.op_src == micro::op_src_rr) {
+              r_get_ptr(l_micro.src.f.r)->i_last = i_code;
+              r_get_ptr(l_micro.src.f.a)->i_last = i_code;
+          }
+      }
+      // assignment: registers are only ever defined by the load that opens their live range, which is always the first
+      // instruction referencing them as a destination
+      for(int i_code = 0; i_code < l_code_size; i_code++) {
+          micro& l_micro = code_head[i_code];
+          if(l_micro.op_dst == micro::op_dst_r) {
+              reg* p_virtual = r_get_ptr(l_micro.dst.r);
+              if(p_virtual->r_phys < 0) {
+                  int i_phys = 0;
+                  while(i_phys < l_phys_count) {
+                      if(r_get_ptr(i_phys)->i_free < i_code) {
+                          break;
+                      }
+                      i_phys++;
+                  }
+                  if(i_phys == l_phys_count) {
+                      l_phys_count++;
+                  }
+                  r_get_ptr(i_phys)->i_free = p_virtual->i_last;
+                  p_virtual->r_phys = i_phys;
+              }
+          }
+      }
+      // rewrite
+      for(int i_code = 0; i_code < l_code_size; i_code++) {
+          micro& l_micro = code_head[i_code];
+          if(l_micro.op_dst == micro::op_dst_r) {
+              l_micro.dst.r = r_get_ptr(l_micro.dst.r)->r_phys * fpu::pts;
+          }
+          if(l_micro.op_src == micro::op_src_r) {
+              l_micro.src.r = r_get_ptr(l_micro.src.r)->r_phys * fpu::pts;
+          } else
+          if(l_micro.op_src == micro::op_src_rr) {
+              l_micro.src.f.r = r_get_ptr(l_micro.src.f.r)->r_phys * fpu::pts;
+              l_micro.src.f.a = r_get_ptr(l_micro.src.f.a)->r_phys * fpu::pts;
+          }
       }
-      // signal that there is a free register waiting to be allocated
-      if(rx < m_r_last) {
-          m_r_last = rx;
+      if(l_phys_count > m_r_max) {
+          m_r_max = l_phys_count;
       }
+      return true;
 }
 
 micro& factory::i_emit_generic(unsigned int op) noexcept
 {
       micro* l_micro = m_i_last++;
-      if(l_micro < m_i_base + m_i_size) {
+      if(l_micro < m_i_base + m_instruction_count) {
           l_micro->op_code = op;
           l_micro->bit_flags = 0u;
           l_micro->bit_const = 0u;
@@ -176,16 +217,26 @@ micro& factory::i_emit_generic(unsigned int op, int lhs, fptype* rhs) noexcept
 
 micro& factory::i_emit_constant_load(const constant& symbol) noexcept
 {
-      micro& l_micro = i_emit_generic(micro::op_code_mov, r_get_scratch(), d_get_constant(symbol));
-      l_micro.bit_const = 1u;
-      return l_micro;
+      if(int l_register = r_get_virtual(); l_register >= 0) {
+          if(fptype* l_data_ptr = d_get_constant(symbol); l_data_ptr != nullptr) {
+              micro& l_micro = i_emit_generic(micro::op_code_mov, l_register, l_data_ptr);
+              l_micro.bit_const = 1u;
+              return l_micro;
+          }
+      }
+      return i_emit_error();
 }
 
 micro& factory::i_emit_variable_load(uniform& symbol) noexcept
 {
-      micro& l_micro = i_emit_generic(micro::op_code_mov, r_get_scratch(), d_get_variable(symbol));
-      l_micro.bit_volatile = 1u;
-      return l_micro;
+      if(int l_register = r_get_virtual(); l_register >= 0) {
+          if(fptype* l_data_ptr = d_get_variable(symbol); l_data_ptr != nullptr) {
+              micro& l_micro = i_emit_generic(micro::op_code_mov, l_register, l_data_ptr);
+              l_micro.bit_volatile = 1u;
+              return l_micro;
+          }
+      }
+      return i_emit_error();
 }
 
 micro& factory::i_emit_operation(unsigned int op, micro& lhs) noexcept
@@ -198,6 +249,15 @@ micro& factory::i_emit_operation(unsigned int op, micro& lhs) noexcept
               return i_emit_generic(micro::op_code_neg, lhs.dst.r, nullptr);
           } else
               return i_emit_error();
+      } else
+      if(op != micro::op_code_nop) {
+          if(lhs.op_dst == micro::op_dst_r) {
+              micro& l_micro = i_emit_generic(op, lhs.dst.r, nullptr);
+              l_micro.bit_volatile = lhs.bit_volatile;
+              l_micro.bit_const = lhs.bit_const;
+              return l_micro;
+          } else
+              return i_emit_error();
       } else
           return i_emit_error();
 }
@@ -216,14 +276,41 @@ micro& factory::i_emit_operation(unsigned int op, micro& lhs, micro& rhs) noexce
                   (rhs.bit_const == 1u)) {
                   l_micro.bit_const = 1u;
               }
-              // drop rhs register
-              r_drop_scratch(rhs.dst.r);
               return l_micro;
           }
       }
       return i_emit_error();
 }
 
+micro& factory::i_emit_operation(unsigned int op, micro& lhs, micro& rhs, micro& acc) noexcept
+{
+      if((lhs.op_dst == micro::op_dst_r) &&
+          (rhs.op_dst == micro::op_dst_r) &&
+          (acc.op_dst == micro::op_dst_r)) {
+          micro& l_micro = i_emit_generic(op);
+          if(is_return_micro(l_micro)) {
+              l_micro.op_dst = micro::op_dst_r;
+              l_micro.dst.r = lhs.dst.r;
+              l_micro.op_src = micro::op_src_rr;
+              l_micro.src.f.r = rhs.dst.r;
+              l_micro.src.f.a = acc.dst.r;
+              // set the operation const and volatile bits
+              if((lhs.bit_volatile == 1u) ||
+                  (rhs.bit_volatile == 1u) ||
+                  (acc.bit_volatile == 1u)) {
+                  l_micro.bit_volatile = 1u;
+              } else
+              if((lhs.bit_const == 1u) &&
+                  (rhs.bit_const == 1u) &&
+                  (acc.bit_const == 1u)) {
+                  l_micro.bit_const = 1u;
+              }
+          }
+          return l_micro;
+      }
+      return i_emit_error();
+}
+
 micro& factory::i_emit_error() noexcept
 {
       micro* l_micro = m_i_error;
@@ -245,33 +332,6 @@ void  factory::i_drop() noexcept
       m_i_last--;
 }
 
-bool   factory::push(sub& b) noexcept
-{
-        b.b_parent = m_b_tail;
-        b.r_lb     = m_r_lb;
-        b.r_ub     = m_r_ub;
-        m_b_tail = std::addressof(b);
-        if(m_b_head == nullptr) {
-            m_b_head = m_b_tail;
-        }
-        return true;
-}
-
-void   factory::pop() noexcept
-{
-        // drop live registers within the range of the current branch
-        for(int i_register = m_b_tail->r_lb; i_register < m_b_tail->r_ub; i_register++) {
-            r_drop_scratch(i_register);
-        }
-        // restore the state saved during the matching push() call
-        m_r_ub = m_b_tail->r_ub;
-        m_r_lb = m_b_tail->r_lb;
-        m_b_tail = m_b_tail->b_parent;
-        if(m_b_tail == nullptr) {
-            m_b_head = nullptr;
-        }
-}
-
 void  factory::build() noexcept
 {
 }
@@ -23,8 +23,11 @@
 **/
 #include "dsp.h"
 #include "core.h"
+#include "lattice/kernel.h"
 #include <util.h>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 
 namespace dsp {
 
@@ -39,37 +42,27 @@ class factory: public core
   micro*    m_i_error;
   micro*    m_return;
   micro*    m_fault;
-  int       m_r_lb;
-  int       m_r_ub;
-  int       m_r_last;
+  int       m_r_max;    // most physical registers live at once over all arguments built so far
 
   private:
-  struct reg;
-  struct sub;
-
   struct alias
   {
     symbol* reference;
     fptype* address;
   };
  
+  /* reg
+     live range of a virtual register; registers are handed out as virtual while an argument is built and mapped onto
+     physical registers by r_allocate() once its code is complete
+  */
   struct reg
   {
-    sub*    b_owner;    // owning branch
-    micro*  i_load;     // instruction where the register is loaded
-  };
-
-  struct sub
-  {
-    sub*    b_parent;   // parent branch
-    int     r_lb;
-    int     r_ub;
+    int     i_last;     // index of the last instruction that references the virtual register
+    int     r_phys;     // physical register assigned to the virtual register, -1 until assigned
+    int     i_free;     // indexed by physical register: index of the instruction after which it becomes free
   };
 
   private:
-  sub*      m_b_head;
-  sub*      m_b_tail;
-
   alias*    m_alias_pool;
   int       m_alias_count;
   reg*      m_live_pool;
@@ -82,9 +75,9 @@ class factory: public core
           fptype*  d_get_constant(const constant&) noexcept;
           fptype*  d_get_variable(uniform&) noexcept;
 
-          int      r_get_scratch() noexcept;
+          int      r_get_virtual() noexcept;
           reg*     r_get_ptr(int) noexcept;
-          void     r_drop_scratch(int) noexcept;
+          bool     r_allocate(micro*, micro*) noexcept;
 
           micro&   i_emit_generic(unsigned int) noexcept;
           micro&   i_emit_generic(unsigned int, int, int) noexcept;
@@ -93,12 +86,11 @@ class factory: public core
           micro&   i_emit_variable_load(uniform&) noexcept;
           micro&   i_emit_operation(unsigned int, micro&) noexcept;
           micro&   i_emit_operation(unsigned int, micro&, micro&) noexcept;
+          micro&   i_emit_operation(unsigned int, micro&, micro&, micro&) noexcept;
           micro&   i_emit_error() noexcept;
           void     i_drop() noexcept;
 
   protected:
-          bool   push(sub&) noexcept;
-          void   pop() noexcept;
           void   build() noexcept;
 
   /* build <constant>
@@ -150,22 +142,43 @@ class factory: public core
           return i_emit_error();
   }
 
+  /* build_in_order
+     build the operands of an operation in Sethi-Ullman order, the operand that needs the most registers first (see
+     get_build_order()), and store the resulting micros by operand position
+  */
+  template<typename... Xt>
+  inline  bool  build_in_order(micro** result, const Xt&... operands) noexcept {
+          constexpr std::array<int, sizeof...(Xt)> l_order = get_build_order<sizeof...(Xt)>({Xt::used_register_count...});
+          for(int i_operand : l_order) {
+              int i_index = 0;
+              ((i_index++ == i_operand ? (result[i_operand] = std::addressof(build(operands)), true) : false) || ...);
+              if(is_return_micro(*result[i_operand]) == false) {
+                  return false;
+              }
+          }
+          return true;
+  }
+
   /* compose
      compose binary operation
   */
   template<typename Lt, typename Rt>
   inline  micro& compose(unsigned int op_code, const Lt& lhs, const Rt& rhs) noexcept {
-          sub bb;
-          micro& li = build(lhs);
-          if(is_return_micro(li)) {
-              if(push(bb)) {
-                  micro& ri = build(rhs);
-                  if(is_return_micro(ri)) {
-                      micro& re = i_emit_operation(op_code, li, ri);
-                      pop();
-                      return re;
-                  }
-              }
+          micro* l_operand[2];
+          if(build_in_order(l_operand, lhs, rhs)) {
+              return i_emit_operation(op_code, *l_operand[0], *l_operand[1]);
+          }
+          return i_emit_error();
+  }
+
+  /* fuse
+     compose fused multiply-add: <lhs> * <rhs> and <acc>, combined as specified by op_code
+  */
+  template<typename Lt, typename Rt, typename At>
+  inline  micro& fuse(unsigned int op_code, const Lt& lhs, const Rt& rhs, const At& acc) noexcept {
+          micro* l_operand[3];
+          if(build_in_order(l_operand, lhs, rhs, acc)) {
+              return i_emit_operation(op_code, *l_operand[0], *l_operand[1], *l_operand[2]);
           }
           return i_emit_error();
   }
@@ -191,6 +204,48 @@ class factory: public core
           return compose(expr, expr.lhs, expr.rhs);
   }
 
+  /* optimize <a> * <b> + <rhs> -> fma
+  */
+  template<typename At, typename Bt, typename Rt>
+  inline  micro& build(const op_add<op_mul<At, Bt>, Rt>& expr) noexcept {
+          return fuse(micro::op_code_fma, expr.lhs.lhs, expr.lhs.rhs, expr.rhs);
+  }
+
+  /* optimize <lhs> + <a> * <b> -> fma
+  */
+  template<typename Lt, typename At, typename Bt>
+  inline  micro& build(const op_add<Lt, op_mul<At, Bt>>& expr) noexcept {
+          return fuse(micro::op_code_fma, expr.rhs.lhs, expr.rhs.rhs, expr.lhs);
+  }
+
+  /* optimize <a> * <b> + <c> * <d> -> fma
+  */
+  template<typename At, typename Bt, typename Ct, typename Dt>
+  inline  micro& build(const op_add<op_mul<At, Bt>, op_mul<Ct, Dt>>& expr) noexcept {
+          return fuse(micro::op_code_fma, expr.lhs.lhs, expr.lhs.rhs, expr.rhs);
+  }
+
+  /* optimize <a> * <b> - <rhs> -> fms
+  */
+  template<typename At, typename Bt, typename Rt>
+  inline  micro& build(const op_sub<op_mul<At, Bt>, Rt>& expr) noexcept {
+          return fuse(micro::op_code_fms, expr.lhs.lhs, expr.lhs.rhs, expr.rhs);
+  }
+
+  /* optimize <lhs> - <a> * <b> -> fnma
+  */
+  template<typename Lt, typename At, typename Bt>
+  inline  micro& build(const op_sub<Lt, op_mul<At, Bt>>& expr) noexcept {
+          return fuse(micro::op_code_fnma, expr.rhs.lhs, expr.rhs.rhs, expr.lhs);
+  }
+
+  /* optimize <a> * <b> - <c> * <d> -> fms
+  */
+  template<typename At, typename Bt, typename Ct, typename Dt>
+  inline  micro& build(const op_sub<op_mul<At, Bt>, op_mul<Ct, Dt>>& expr) noexcept {
+          return fuse(micro::op_code_fms, expr.lhs.lhs, expr.lhs.rhs, expr.rhs);
+  }
+
   /* build <lhs> / <rhs>
   */
   template<typename Lt, typename Rt>
@@ -198,33 +253,166 @@ class factory: public core
           return compose(expr, expr.lhs, expr.rhs);
   }
 
+  /* build min(<lhs>, <rhs>)
+  */
+  template<typename Lt, typename Rt>
+  inline  micro& build(const op_min<Lt, Rt>& expr) noexcept {
+          return compose(expr, expr.lhs, expr.rhs);
+  }
+
+  /* build max(<lhs>, <rhs>)
+  */
+  template<typename Lt, typename Rt>
+  inline  micro& build(const op_max<Lt, Rt>& expr) noexcept {
+          return compose(expr, expr.lhs, expr.rhs);
+  }
+
+  /* build pow(<lhs>, <rhs>)
+  */
+  template<typename Lt, typename Rt, unsigned int Tier>
+  inline  micro& build(const op_pow<Lt, Rt, Tier>& expr) noexcept {
+          micro& re = compose(expr, expr.lhs, expr.rhs);
+          if(is_return_micro(re)) {
+              re.bit_flags = Tier;
+          }
+          return re;
+  }
+
+  /* apply
+     compose unary operation
+  */
+  template<typename Lt>
+  inline  micro& apply(unsigned int op_code, unsigned int tier, const Lt& lhs) noexcept {
+          micro& li = build(lhs);
+          if(is_return_micro(li)) {
+              micro& re = i_emit_operation(op_code, li);
+              if(is_return_micro(re)) {
+                  re.bit_flags = tier;
+              }
+              return re;
+          }
+          return i_emit_error();
+  }
+
+  /* build abs(<lhs>)
+  */
+  template<typename Lt>
+  inline  micro& build(const op_abs<Lt>& expr) noexcept {
+          return apply(expr, micro::tier_default, expr.lhs);
+  }
+
+  /* build sqrt(<lhs>)
+  */
+  template<typename Lt>
+  inline  micro& build(const op_sqrt<Lt>& expr) noexcept {
+          return apply(expr, micro::tier_default, expr.lhs);
+  }
+
+  /* build exp(<lhs>)
+  */
+  template<typename Lt, unsigned int Tier>
+  inline  micro& build(const op_exp<Lt, Tier>& expr) noexcept {
+          return apply(expr, Tier, expr.lhs);
+  }
+
+  /* build log(<lhs>)
+  */
+  template<typename Lt, unsigned int Tier>
+  inline  micro& build(const op_log<Lt, Tier>& expr) noexcept {
+          return apply(expr, Tier, expr.lhs);
+  }
+
+  /* build sin(<lhs>)
+  */
+  template<typename Lt, unsigned int Tier>
+  inline  micro& build(const op_sin<Lt, Tier>& expr) noexcept {
+          return apply(expr, Tier, expr.lhs);
+  }
+
+  /* build cos(<lhs>)
+  */
+  template<typename Lt, unsigned int Tier>
+  inline  micro& build(const op_cos<Lt, Tier>& expr) noexcept {
+          return apply(expr, Tier, expr.lhs);
+  }
+
+  /* build tanh(<lhs>)
+  */
+  template<typename Lt, unsigned int Tier>
+  inline  micro& build(const op_tanh<Lt, Tier>& expr) noexcept {
+          return apply(expr, Tier, expr.lhs);
+  }
+
+  /* build select(<cond>, <lhs>, <rhs>)
+     mask = msk <cond>; <lhs> &= mask; mask = ~mask & <rhs>; <lhs> |= mask
+  */
+  template<typename Ct, typename Lt, typename Rt>
+  inline  micro& build(const op_select<Ct, Lt, Rt>& expr) noexcept {
+          micro* l_operand[3];
+          if(build_in_order(l_operand, expr.cond, expr.lhs, expr.rhs)) {
+              micro& ci = i_emit_operation(micro::op_code_msk, *l_operand[0]);
+              micro& li = *l_operand[1];
+              micro& ri = *l_operand[2];
+              if(is_return_micro(ci)) {
+                  micro& ti = i_emit_generic(micro::op_code_and, li.dst.r, ci.dst.r);
+                  if(is_return_micro(ti)) {
+                      ti.bit_volatile = li.bit_volatile | ci.bit_volatile;
+                      ti.bit_const = li.bit_const & ci.bit_const;
+                      micro& fi = i_emit_operation(micro::op_code_andn, ci, ri);
+                      if(is_return_micro(fi)) {
+                          return i_emit_operation(micro::op_code_or, ti, fi);
+                      }
+                  }
+              }
+          }
+          return i_emit_error();
+  }
+
+  /* make_uniforms()
+     reserve the data registers of all uniforms ahead of the code, in the order kernel_bind() walks the arguments, so that
+     the uniforms occupy the leading data registers and a program image can rebind them by position
+  */
+  template<typename... Args>
+  inline  void  make_uniforms(Args&&... arguments) noexcept {
+          auto l_bind = [this](uniform& symbol) noexcept {
+              d_get_variable(symbol);
+          };
+          ([&]() noexcept {
+              using Xt = std::remove_cvref_t<Args>;
+              if constexpr(std::is_same_v<Xt, uniform>) {
+                  l_bind(arguments);
+              } else
+              if constexpr(requires { Xt::used_instruction_count; }) {
+                  kernel_bind(arguments, l_bind);
+              }
+          }(), ...);
+          m_uniform_count = m_alias_count;
+  }
+
   inline  bool  make_argument(int) noexcept {
           return true;
   }
 
   template<typename Expr, typename... Next>
   inline  bool  make_argument(int index, Expr&& expr, Next&&... next) noexcept {
-          sub   l_ab;
           bool  l_result = false;
-          if(push(l_ab)) {
-              auto  l_code_head = m_i_last;
-              auto& l_return    = build(expr);
-              auto  l_code_tail = m_i_last;
-              auto  l_argument  = new(m_argv + index) argument(l_code_head, l_code_tail);
-              if(l_argument) {
-                  if(l_return.op_dst == micro::op_dst_r) {
-                      if(l_return.op_code != micro::op_code_nop) {
-                          l_return.bit_halt = 1u;
-                          l_return.bit_return = 1u;
-                          l_result = true;
-                      } else
-                          i_emit_error();
+          auto  l_code_head = m_i_last;
+          m_live_count = 0;
+          auto& l_return    = build(expr);
+          auto  l_code_tail = m_i_last;
+          auto  l_argument  = new(m_argv + index) argument(l_code_head, l_code_tail);
+          if(l_argument) {
+              if(l_return.op_dst == micro::op_dst_r) {
+                  if(l_return.op_code != micro::op_code_nop) {
+                      l_return.bit_halt = 1u;
+                      l_return.bit_return = 1u;
+                      l_result = r_allocate(l_code_head, l_code_tail);
                   } else
                       i_emit_error();
-              }
-              m_i_error = m_i_last;
-              pop();
+              } else
+                  i_emit_error();
           }
+          m_i_error = m_i_last;
           return make_argument(index + 1, std::forward<Next>(next)...) && l_result;
   }
 
@@ -259,40 +447,35 @@ class factory: public core
               } else
                   return;
 
-              m_arg_size = get_list_size_ub(std::forward<Args>(arguments)...) * sizeof(argument);
-              if(m_argv = reinterpret_cast<argument*>(malloc(m_arg_size));
-                  m_argv != nullptr) {
-                  m_d_size = m_variable_count * fpu::pts * sizeof(fptype);
-                  if(m_d_base = reinterpret_cast<fptype*>(malloc(m_d_size));
-                      m_d_base != nullptr) {
-                      m_i_size = m_instruction_count * sizeof(micro);
-                      if(m_i_base = reinterpret_cast<micro*>(malloc(m_i_size));
-                          m_i_base != nullptr) {
-                          alias l_alias_pool[m_variable_count];
-                          reg   l_live_pool[m_register_count];
-
-                          m_d_last = m_d_base;
-                          m_i_last = m_i_base;
-                          m_i_error = m_i_base;
-                          m_fault  = nullptr;
-                          m_return = nullptr;
-                          m_r_lb   = 0;
-                          m_r_ub   = m_register_count;
-                          m_r_last = m_r_lb;
-
-                          m_b_head = nullptr;
-                          m_b_tail = nullptr;
-
-                          m_alias_pool = std::addressof(l_alias_pool[0]);
-                          m_alias_count = 0;
-                          m_live_pool = std::addressof(l_live_pool[0]);
-                          m_live_count = 0;
-                          std::memset(m_live_pool, 0, m_register_count * sizeof(reg));
-
-                          m_result = make_argument(0, std::forward<Args>(arguments)...);
-                      }
+              if(make_storage(
+                      m_variable_count * fpu::pts * sizeof(fptype),
+                      m_instruction_count * sizeof(micro),
+                      get_list_size_ub(std::forward<Args>(arguments)...) * sizeof(argument))) {
+                  // every leaf of an argument loads into a virtual register of its own, so the variable count also
+                  // bounds the number of virtual registers in any one argument
+                  alias l_alias_pool[m_variable_count];
+                  reg   l_live_pool[m_variable_count];
+
+                  std::memset(m_d_base, 0, m_d_size);
+                  m_d_last = m_d_base;
+                  m_i_last = m_i_base;
+                  m_i_error = m_i_base;
+                  m_fault  = nullptr;
+                  m_return = nullptr;
+                  m_r_max  = 0;
+
+                  m_alias_pool = std::addressof(l_alias_pool[0]);
+                  m_alias_count = 0;
+                  m_live_pool = std::addressof(l_live_pool[0]);
+                  m_live_count = 0;
+
+                  make_uniforms(std::forward<Args>(arguments)...);
+                  m_result = make_argument(0, std::forward<Args>(arguments)...);
+                  if(m_result) {
+                      m_register_count = m_r_max;
                   }
-              }
+              } else
+                  m_result = false;
           }
   }
 
@@ -303,8 +486,7 @@ class factory: public core
 
 /* operator <uniform>
 */
-template<typename Lt>
-constexpr auto operator+(uniform& lhs) noexcept
+inline auto operator+(uniform& lhs) noexcept
 {
       return reference<uniform>(lhs);
 }
@@ -317,8 +499,7 @@ constexpr auto operator+(const Lt& lhs) noexcept
 
 /* operator -<expr>
 */
-template<typename Lt>
-constexpr auto operator-(uniform& lhs) noexcept
+inline auto operator-(uniform& lhs) noexcept
 {
       return op_neg<reference<uniform>>(lhs);
 }
@@ -329,6 +510,56 @@ constexpr auto operator-(const Lt& lhs) noexcept
       return op_neg<Lt>(lhs);
 }
 
+/* operator <constant>
+   operations where every operand is a constant fold into a single constant, at compile time where the operands are
+   constant expressions; together with the constexpr members of `constant` this covers +, -, * and / of constants and
+   numbers
+*/
+constexpr constant operator-(const constant& lhs) noexcept
+{
+      return constant(-lhs.get_value());
+}
+
+constexpr constant operator+(const constant& lhs, fptype rhs) noexcept
+{
+      return constant(lhs.get_value() + rhs);
+}
+
+constexpr constant operator+(fptype lhs, const constant& rhs) noexcept
+{
+      return constant(lhs + rhs.get_value());
+}
+
+constexpr constant operator-(const constant& lhs, fptype rhs) noexcept
+{
+      return constant(lhs.get_value() - rhs);
+}
+
+constexpr constant operator-(fptype lhs, const constant& rhs) noexcept
+{
+      return constant(lhs - rhs.get_value());
+}
+
+constexpr constant operator*(const constant& lhs, fptype rhs) noexcept
+{
+      return constant(lhs.get_value() * rhs);
+}
+
+constexpr constant operator*(fptype lhs, const constant& rhs) noexcept
+{
+      return constant(lhs * rhs.get_value());
+}
+
+constexpr constant operator/(const constant& lhs, fptype rhs) noexcept
+{
+      return constant(lhs.get_value() / rhs);
+}
+
+constexpr constant operator/(fptype lhs, const constant& rhs) noexcept
+{
+      return constant(lhs / rhs.get_value());
+}
+
 /* operator <expr> + <expr>
 */
 template<typename Lt>
@@ -365,6 +596,11 @@ inline auto operator+(float lhs, uniform& rhs) noexcept
       return op_add<constant, reference<uniform>>(lhs, rhs);
 }
 
+inline auto operator+(uniform& lhs, uniform& rhs) noexcept
+{
+      return op_add<reference<uniform>, reference<uniform>>(lhs, rhs);
+}
+
 template<typename Lt, typename Rt>
 constexpr auto operator+(const Lt& lhs, const Rt& rhs) noexcept
 {
@@ -407,6 +643,11 @@ inline auto operator-(float lhs, uniform& rhs) noexcept
       return op_sub<constant, reference<uniform>>(lhs, rhs);
 }
 
+inline auto operator-(uniform& lhs, uniform& rhs) noexcept
+{
+      return op_sub<reference<uniform>, reference<uniform>>(lhs, rhs);
+}
+
 template<typename Lt, typename Rt>
 constexpr auto operator-(const Lt& lhs, const Rt& rhs) noexcept
 {
@@ -449,6 +690,11 @@ inline auto operator*(float lhs, uniform& rhs) noexcept
       return op_mul<constant, reference<uniform>>(lhs, rhs);
 }
 
+inline auto operator*(uniform& lhs, uniform& rhs) noexcept
+{
+      return op_mul<reference<uniform>, reference<uniform>>(lhs, rhs);
+}
+
 template<typename Lt, typename Rt>
 constexpr auto operator*(const Lt& lhs, const Rt& rhs) noexcept
 {
@@ -491,12 +737,179 @@ inline auto operator/(float lhs, uniform& rhs) noexcept
       return op_div<constant, reference<uniform>>(lhs, rhs);
 }
 
+inline auto operator/(uniform& lhs, uniform& rhs) noexcept
+{
+      return op_div<reference<uniform>, reference<uniform>>(lhs, rhs);
+}
+
 template<typename Lt, typename Rt>
 constexpr auto operator/(const Lt& lhs, const Rt& rhs) noexcept
 {
       return op_div<Lt, Rt>(lhs, rhs);
 }
 
+/* is_expression
+   lattice expression nodes and symbols, as opposed to plain numbers
+*/
+template<typename Xt>
+concept is_expression = requires { std::remove_cvref_t<Xt>::used_instruction_count; };
+
+template<typename Xt>
+concept is_operand = is_expression<Xt> || std::is_arithmetic_v<std::remove_cvref_t<Xt>>;
+
+/* lift()
+   convert an operand of a lattice function into an expression node: numbers become constants and uniforms are
+   referenced
+*/
+inline auto lift(uniform& lhs) noexcept
+{
+      return reference<uniform>(lhs);
+}
+
+constexpr auto lift(fptype lhs) noexcept
+{
+      return constant(lhs);
+}
+
+template<typename Xt> requires is_expression<Xt>
+constexpr const Xt& lift(const Xt& lhs) noexcept
+{
+      return lhs;
+}
+
+template<typename Xt>
+using lift_t = std::remove_cvref_t<decltype(lift(std::declval<Xt>()))>;
+
+/* is_constant
+   operands that lift to a constant: the functions below fold these at compile time instead of building a node
+*/
+template<typename Xt>
+concept is_constant = std::is_same_v<lift_t<Xt>, constant>;
+
+/* min(<expr>, <expr>), max(<expr>, <expr>)
+*/
+template<typename Lt, typename Rt> requires is_operand<Lt> && is_operand<Rt> && (is_expression<Lt> || is_expression<Rt>)
+constexpr auto min(Lt&& lhs, Rt&& rhs) noexcept
+{
+      if constexpr (is_constant<Lt> && is_constant<Rt>) {
+          fptype l_x = lift(lhs).get_value();
+          fptype l_y = lift(rhs).get_value();
+          return constant(l_y < l_x ? l_y : l_x);
+      } else
+          return op_min<lift_t<Lt>, lift_t<Rt>>(lift(lhs), lift(rhs));
+}
+
+template<typename Lt, typename Rt> requires is_operand<Lt> && is_operand<Rt> && (is_expression<Lt> || is_expression<Rt>)
+constexpr auto max(Lt&& lhs, Rt&& rhs) noexcept
+{
+      if constexpr (is_constant<Lt> && is_constant<Rt>) {
+          fptype l_x = lift(lhs).get_value();
+          fptype l_y = lift(rhs).get_value();
+          return constant(l_y > l_x ? l_y : l_x);
+      } else
+          return op_max<lift_t<Lt>, lift_t<Rt>>(lift(lhs), lift(rhs));
+}
+
+/* clamp(<expr>, <lb>, <ub>)
+   lowered to min(max(<expr>, <lb>), <ub>)
+*/
+template<typename Xt, typename Lt, typename Ut> requires is_expression<Xt> && is_operand<Lt> && is_operand<Ut>
+constexpr auto clamp(Xt&& expr, Lt&& lb, Ut&& ub) noexcept
+{
+      return min(max(std::forward<Xt>(expr), std::forward<Lt>(lb)), std::forward<Ut>(ub));
+}
+
+/* abs(<expr>), sqrt(<expr>)
+*/
+template<typename Lt> requires is_expression<Lt>
+constexpr auto abs(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          fptype l_x = lift(lhs).get_value();
+          return constant(l_x < 0 ? -l_x : (l_x == 0 ? 0 : l_x));
+      } else
+          return op_abs<lift_t<Lt>>(lift(lhs));
+}
+
+template<typename Lt> requires is_expression<Lt>
+constexpr auto sqrt(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          return constant(std::sqrt(lift(lhs).get_value()));
+      } else
+          return op_sqrt<lift_t<Lt>>(lift(lhs));
+}
+
+/* exp(<expr>), log(<expr>), sin(<expr>), cos(<expr>), tanh(<expr>), pow(<expr>, <expr>)
+   the accuracy tier may be given explicitly, i.e. `exp<micro::tier_fast>(x)`
+*/
+template<unsigned int Tier = micro::tier_default, typename Lt> requires is_expression<Lt>
+constexpr auto exp(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          return constant(rt_exp<Tier>(lift(lhs).get_value()));
+      } else
+          return op_exp<lift_t<Lt>, Tier>(lift(lhs));
+}
+
+template<unsigned int Tier = micro::tier_default, typename Lt> requires is_expression<Lt>
+constexpr auto log(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          return constant(rt_log<Tier>(lift(lhs).get_value()));
+      } else
+          return op_log<lift_t<Lt>, Tier>(lift(lhs));
+}
+
+template<unsigned int Tier = micro::tier_default, typename Lt> requires is_expression<Lt>
+constexpr auto sin(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          return constant(rt_sin<Tier>(lift(lhs).get_value()));
+      } else
+          return op_sin<lift_t<Lt>, Tier>(lift(lhs));
+}
+
+template<unsigned int Tier = micro::tier_default, typename Lt> requires is_expression<Lt>
+constexpr auto cos(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          return constant(rt_cos<Tier>(lift(lhs).get_value()));
+      } else
+          return op_cos<lift_t<Lt>, Tier>(lift(lhs));
+}
+
+template<unsigned int Tier = micro::tier_default, typename Lt> requires is_expression<Lt>
+constexpr auto tanh(Lt&& lhs) noexcept
+{
+      if constexpr (is_constant<Lt>) {
+          return constant(rt_tanh<Tier>(lift(lhs).get_value()));
+      } else
+          return op_tanh<lift_t<Lt>, Tier>(lift(lhs));
+}
+
+template<unsigned int Tier = micro::tier_default, typename Lt, typename Rt>
+  requires is_operand<Lt> && is_operand<Rt> && (is_expression<Lt> || is_expression<Rt>)
+constexpr auto pow(Lt&& lhs, Rt&& rhs) noexcept
+{
+      if constexpr (is_constant<Lt> && is_constant<Rt>) {
+          return constant(rt_pow<Tier>(lift(lhs).get_value(), lift(rhs).get_value()));
+      } else
+          return op_pow<lift_t<Lt>, lift_t<Rt>, Tier>(lift(lhs), lift(rhs));
+}
+
+/* select(<cond>, <lhs>, <rhs>)
+   <lhs> where <cond> is greater than zero, <rhs> elsewhere
+*/
+template<typename Ct, typename Lt, typename Rt> requires is_expression<Ct> && is_operand<Lt> && is_operand<Rt>
+constexpr auto select(Ct&& cond, Lt&& lhs, Rt&& rhs) noexcept
+{
+      if constexpr (is_constant<Ct> && is_constant<Lt> && is_constant<Rt>) {
+          return lift(cond).get_value() > 0 ? constant(lift(lhs)) : constant(lift(rhs));
+      } else
+          return op_select<lift_t<Ct>, lift_t<Lt>, lift_t<Rt>>(lift(cond), lift(lhs), lift(rhs));
+}
+
 namespace util {
 
 constexpr int get_variable_count() noexcept
@@ -0,0 +1,254 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "fft.h"
+#include "table.h"
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+namespace dsp {
+
+/* table_t
+   tables for a transform of `size` real values, computed as a complex transform of `half` values:
+   `order` is the bit reversal permutation, `w_*` the twiddles of each stage of the complex transform laid out one stage
+   after the other (the stage with butterflies `h` wide starts at `h - 1`) and `s_*` the twiddles that split the complex
+   result into the spectrum of the real input; the arrays follow the header within the same table store entry
+*/
+struct fft::table_t
+{
+  int       size;
+  int       half;
+  int*      order;
+  fptype*   w_re;
+  fptype*   w_im;
+  fptype*   s_re;
+  fptype*   s_im;
+};
+
+static std::size_t fft_get_table_size(int size) noexcept
+{
+      std::size_t l_half = size / 2;
+      return get_round_value(sizeof(fft::table_t), sizeof(fptype) * memory_vector_block) +
+          l_half * sizeof(int) + l_half * 4 * sizeof(fptype);
+}
+
+/* fft_build_table()
+   table store generator for the tables of a transform of the given size
+*/
+static bool  fft_build_table(void* data, std::size_t, const void* key, void*) noexcept
+{
+      int   l_size = *reinterpret_cast<const int*>(key);
+      int   l_half = l_size / 2;
+      int   l_bits = std::countr_zero(static_cast<unsigned int>(l_half));
+      auto  p_table = reinterpret_cast<fft::table_t*>(data);
+      auto  p_base = reinterpret_cast<char*>(data) + get_round_value(sizeof(fft::table_t), sizeof(fptype) * memory_vector_block);
+      p_table->w_re = reinterpret_cast<fptype*>(p_base);
+      p_table->w_im = p_table->w_re + l_half;
+      p_table->s_re = p_table->w_im + l_half;
+      p_table->s_im = p_table->s_re + l_half;
+      p_table->order = reinterpret_cast<int*>(p_table->s_im + l_half);
+      for(int i_index = 0; i_index < l_half; i_index++) {
+          unsigned int l_reverse = 0u;
+          for(int i_bit = 0; i_bit < l_bits; i_bit++) {
+              if(i_index & (1 << i_bit)) {
+                  l_reverse |= 1u << (l_bits - 1 - i_bit);
+              }
+          }
+          p_table->order[i_index] = l_reverse;
+      }
+      for(int i_width = 1; i_width < l_half; i_width *= 2) {
+          for(int i_index = 0; i_index < i_width; i_index++) {
+              double l_angle = -std::numbers::pi * i_index / i_width;
+              p_table->w_re[i_width - 1 + i_index] = std::cos(l_angle);
+              p_table->w_im[i_width - 1 + i_index] = std::sin(l_angle);
+          }
+      }
+      for(int i_index = 0; i_index < l_half; i_index++) {
+          double l_angle = -2.0 * std::numbers::pi * i_index / l_size;
+          p_table->s_re[i_index] = std::cos(l_angle);
+          p_table->s_im[i_index] = std::sin(l_angle);
+      }
+      p_table->size = l_size;
+      p_table->half = l_half;
+      return true;
+}
+
+      fft::fft() noexcept:
+      m_table(nullptr),
+      m_work_re(nullptr),
+      m_work_im(nullptr),
+      m_size(0)
+{
+}
+
+      fft::fft(int size) noexcept:
+      fft()
+{
+      reset(size);
+}
+
+      fft::~fft()
+{
+      dispose();
+}
+
+/* dsp_transform()
+   in-place radix-2 decimation in time transform of the complex values in the work arrays, which are expected in bit
+   reversed order
+*/
+void  fft::dsp_transform(fptype* re, fptype* im) const noexcept
+{
+      int l_half = m_table->half;
+      for(int i_width = 1; i_width < l_half; i_width *= 2) {
+          const fptype* l_w_re = m_table->w_re + i_width - 1;
+          const fptype* l_w_im = m_table->w_im + i_width - 1;
+          for(int i_base = 0; i_base < l_half; i_base += i_width * 2) {
+              fptype* l_a_re = re + i_base;
+              fptype* l_a_im = im + i_base;
+              fptype* l_b_re = l_a_re + i_width;
+              fptype* l_b_im = l_a_im + i_width;
+              for(int i_index = 0; i_index < i_width; i_index++) {
+                  fptype l_t_re = l_b_re[i_index] * l_w_re[i_index] - l_b_im[i_index] * l_w_im[i_index];
+                  fptype l_t_im = l_b_re[i_index] * l_w_im[i_index] + l_b_im[i_index] * l_w_re[i_index];
+                  l_b_re[i_index] = l_a_re[i_index] - l_t_re;
+                  l_b_im[i_index] = l_a_im[i_index] - l_t_im;
+                  l_a_re[i_index] = l_a_re[i_index] + l_t_re;
+                  l_a_im[i_index] = l_a_im[i_index] + l_t_im;
+              }
+          }
+      }
+}
+
+/* reset()
+   set the transform up for `size` real values; `size` needs to be a power of two, 4 or more
+*/
+bool  fft::reset(int size) noexcept
+{
+      if((size >= 4) &&
+          std::has_single_bit(static_cast<unsigned int>(size))) {
+          auto l_table = reinterpret_cast<const table_t*>(tbl_acquire(tbl_fft, size, fft_get_table_size(size), fft_build_table));
+          if(l_table != nullptr) {
+              fptype* l_work = reinterpret_cast<fptype*>(malloc(size * sizeof(fptype)));
+              if(l_work != nullptr) {
+                  dispose();
+                  m_table = l_table;
+                  m_work_re = l_work;
+                  m_work_im = l_work + size / 2;
+                  m_size = size;
+                  return true;
+              }
+              tbl_release(l_table);
+          }
+      }
+      return false;
+}
+
+void  fft::dispose() noexcept
+{
+      if(m_table != nullptr) {
+          tbl_release(m_table);
+          free(m_work_re);
+          m_table = nullptr;
+          m_work_re = nullptr;
+          m_work_im = nullptr;
+          m_size = 0;
+      }
+}
+
+/* forward()
+   transform `size` real values onto `size / 2 + 1` complex bins, from DC to Nyquist; not normalized
+*/
+void  fft::forward(const fptype* data, fptype* re, fptype* im) noexcept
+{
+      int l_half = m_table->half;
+      // pack the even and odd samples as the real and imaginary parts of a half sized complex sequence
+      for(int i_index = 0; i_index < l_half; i_index++) {
+          int l_order = m_table->order[i_index];
+          m_work_re[l_order] = data[i_index * 2];
+          m_work_im[l_order] = data[i_index * 2 + 1];
+      }
+      dsp_transform(m_work_re, m_work_im);
+      // split the transforms of the even and odd samples apart and recombine them into the spectrum of the whole
+      re[0] = m_work_re[0] + m_work_im[0];
+      im[0] = 0.0f;
+      re[l_half] = m_work_re[0] - m_work_im[0];
+      im[l_half] = 0.0f;
+      for(int i_bin = 1; i_bin < l_half; i_bin++) {
+          fptype l_z_re = m_work_re[i_bin];
+          fptype l_z_im = m_work_im[i_bin];
+          fptype l_c_re = m_work_re[l_half - i_bin];
+          fptype l_c_im = 0.0f - m_work_im[l_half - i_bin];
+          fptype l_e_re = (l_z_re + l_c_re) * 0.5f;
+          fptype l_e_im = (l_z_im + l_c_im) * 0.5f;
+          fptype l_o_re = (l_z_im - l_c_im) * 0.5f;
+          fptype l_o_im = (l_c_re - l_z_re) * 0.5f;
+          re[i_bin] = l_e_re + m_table->s_re[i_bin] * l_o_re - m_table->s_im[i_bin] * l_o_im;
+          im[i_bin] = l_e_im + m_table->s_re[i_bin] * l_o_im + m_table->s_im[i_bin] * l_o_re;
+      }
+}
+
+/* inverse()
+   transform `size / 2 + 1` complex bins back onto `size` real values, such that inverse(forward(x)) == x
+*/
+void  fft::inverse(const fptype* re, const fptype* im, fptype* data) noexcept
+{
+      int    l_half = m_table->half;
+      fptype l_scale = 1.0f / static_cast<fptype>(l_half);
+      // rebuild the half sized complex spectrum, conjugated so that the forward transform computes the inverse one
+      for(int i_bin = 0; i_bin < l_half; i_bin++) {
+          fptype l_a_re = re[i_bin];
+          fptype l_a_im = im[i_bin];
+          fptype l_b_re = re[l_half - i_bin];
+          fptype l_b_im = 0.0f - im[l_half - i_bin];
+          fptype l_e_re = (l_a_re + l_b_re) * 0.5f;
+          fptype l_e_im = (l_a_im + l_b_im) * 0.5f;
+          fptype l_d_re = (l_a_re - l_b_re) * 0.5f;
+          fptype l_d_im = (l_a_im - l_b_im) * 0.5f;
+          fptype l_o_re = l_d_re * m_table->s_re[i_bin] + l_d_im * m_table->s_im[i_bin];
+          fptype l_o_im = l_d_im * m_table->s_re[i_bin] - l_d_re * m_table->s_im[i_bin];
+          int    l_order = m_table->order[i_bin];
+          m_work_re[l_order] = l_e_re - l_o_im;
+          m_work_im[l_order] = 0.0f - (l_e_im + l_o_re);
+      }
+      dsp_transform(m_work_re, m_work_im);
+      for(int i_index = 0; i_index < l_half; i_index++) {
+          data[i_index * 2] = m_work_re[i_index] * l_scale;
+          data[i_index * 2 + 1] = 0.0f - m_work_im[i_index] * l_scale;
+      }
+}
+
+int   fft::get_size() const noexcept
+{
+      return m_size;
+}
+
+int   fft::get_bin_count() const noexcept
+{
+      return m_size / 2 + 1;
+}
+
+bool  fft::is_valid() const noexcept
+{
+      return m_table != nullptr;
+}
+
+/*namespace dsp*/ }
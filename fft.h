@@ -0,0 +1,69 @@
+#ifndef dsp_fft_h
+#define dsp_fft_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+
+namespace dsp {
+
+/* fft
+   real to complex fast fourier transform of a power of two size; the transform of `size` real values is computed as a
+   complex transform of half the size, in split (separate real and imaginary arrays) form, such that the butterflies of a
+   stage run over contiguous memory; twiddle factors are computed once per size and shared between the instances
+*/
+class fft
+{
+  public:
+  struct table_t;
+
+  private:
+  const table_t* m_table;
+  fptype*   m_work_re;
+  fptype*   m_work_im;
+  int       m_size;
+
+  protected:
+          void    dsp_transform(fptype*, fptype*) const noexcept;
+
+  public:
+          fft() noexcept;
+          fft(int) noexcept;
+          fft(const fft&) noexcept = delete;
+          fft(fft&&) noexcept = delete;
+          ~fft();
+
+          bool    reset(int) noexcept;
+          void    dispose() noexcept;
+
+          void    forward(const fptype*, fptype*, fptype*) noexcept;
+          void    inverse(const fptype*, const fptype*, fptype*) noexcept;
+
+          int     get_size() const noexcept;
+          int     get_bin_count() const noexcept;
+          bool    is_valid() const noexcept;
+
+          fft&    operator=(const fft&) noexcept = delete;
+          fft&    operator=(fft&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
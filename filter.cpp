@@ -0,0 +1,181 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "filter.h"
+#include <bit>
+#include <cstring>
+
+namespace dsp {
+
+      filter::filter(int lanes, int stages) noexcept:
+      core(o_none),
+      m_input(this),
+      m_lane_count(0),
+      m_stage_count(stages > 0 ? stages : 1),
+      m_rate(0),
+      m_param_back(0u),
+      m_param_front(2u),
+      m_param_swap(1u | swap_update_bit)
+{
+      for(int i_lane = 0; i_lane < lane_max; i_lane++) {
+          m_param[i_lane].shape = shape_lowpass;
+          m_param[i_lane].frequency = 1000.0f;
+          m_param[i_lane].q = 0.70710678f;
+          m_param[i_lane].gain = 0.0f;
+      }
+      for(int i_set = 0; i_set < 3; i_set++) {
+          std::memcpy(m_param_set[i_set], m_param, sizeof(m_param));
+      }
+      if((lanes > 0) &&
+          (lanes <= lane_max) &&
+          std::has_single_bit(static_cast<unsigned int>(lanes))) {
+          m_lane_count = lanes;
+          set_sample_format(fmt_pcm | std::countr_zero(static_cast<unsigned int>(lanes)));
+      }
+}
+
+      filter::~filter()
+{
+}
+
+/* set_update()
+   control thread: publish the parameters of all lanes to the render thread; the back set is filled and swapped with the
+   middle one, which it replaces as the newest
+*/
+void  filter::set_update() noexcept
+{
+      std::memcpy(m_param_set[m_param_back], m_param, sizeof(m_param));
+      m_param_back = m_param_swap.exchange(m_param_back | swap_update_bit, std::memory_order_acq_rel) & swap_index_mask;
+}
+
+/* dsp_prepare()
+   bring the coefficients up to date with the parameters and the rate of the current branch; fails if the branch doesn't
+   carry one channel per lane
+*/
+bool  filter::dsp_prepare() noexcept
+{
+      if(dsp_get_sample_size() != m_lane_count) {
+          return false;
+      }
+      int  l_rate = dsp_get_sample_rate();
+      bool l_update = false;
+      if(m_param_swap.load(std::memory_order_relaxed) & swap_update_bit) {
+          // newer parameters were published: take the middle set over as the front one
+          m_param_front = m_param_swap.exchange(m_param_front, std::memory_order_acq_rel) & swap_index_mask;
+          l_update = true;
+      }
+      if(l_update ||
+          (l_rate != m_rate)) {
+          for(int i_lane = 0; i_lane < m_lane_count; i_lane++) {
+              param_t l_param = m_param_set[m_param_front][i_lane];
+              // keep the frequency within the band of the branch
+              if(l_param.frequency > l_rate * 0.49f) {
+                  l_param.frequency = l_rate * 0.49f;
+              } else
+              if(l_param.frequency < 1.0f) {
+                  l_param.frequency = 1.0f;
+              }
+              if(l_param.q < 0.01f) {
+                  l_param.q = 0.01f;
+              }
+              dsp_update(i_lane, l_param, l_rate);
+          }
+          m_rate = l_rate;
+      }
+      return true;
+}
+
+bool  filter::set(int lane, unsigned int shape, float frequency, float q, float gain) noexcept
+{
+      if((lane >= 0) &&
+          (lane < m_lane_count) &&
+          (shape <= shape_highshelf)) {
+          m_param[lane].shape = shape;
+          m_param[lane].frequency = frequency;
+          m_param[lane].q = q;
+          m_param[lane].gain = gain;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  filter::set_shape(int lane, unsigned int value) noexcept
+{
+      if((lane >= 0) &&
+          (lane < m_lane_count) &&
+          (value <= shape_highshelf)) {
+          m_param[lane].shape = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  filter::set_frequency(int lane, float value) noexcept
+{
+      if((lane >= 0) &&
+          (lane < m_lane_count)) {
+          m_param[lane].frequency = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  filter::set_q(int lane, float value) noexcept
+{
+      if((lane >= 0) &&
+          (lane < m_lane_count)) {
+          m_param[lane].q = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  filter::set_gain(int lane, float value) noexcept
+{
+      if((lane >= 0) &&
+          (lane < m_lane_count)) {
+          m_param[lane].gain = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+gate& filter::get_input() noexcept
+{
+      return m_input;
+}
+
+int   filter::get_lane_count() const noexcept
+{
+      return m_lane_count;
+}
+
+int   filter::get_stage_count() const noexcept
+{
+      return m_stage_count;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,104 @@
+#ifndef dsp_filter_h
+#define dsp_filter_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include <atomic>
+
+namespace dsp {
+
+/* filter
+   base for the filter banks: a bank runs one independent filter per channel of the format it renders in (1, 2, 4 or 8
+   lanes), each one a cascade of `stages` identical sections; the lanes of a frame are processed side by side, such that
+   the per-sample recursion vectorises across filters rather than along time; parameters are set per lane and the
+   coefficients are recomputed on the render thread, at most once per render pass and only after a change; the parameters
+   of all lanes travel from the control thread to the render thread as a whole, through a triple buffer, such that the
+   render never sees a set that is only partly written
+*/
+class filter: public core
+{
+  public:
+  static constexpr unsigned int shape_lowpass = 0u;
+  static constexpr unsigned int shape_highpass = 1u;
+  static constexpr unsigned int shape_bandpass = 2u;
+  static constexpr unsigned int shape_notch = 3u;
+  static constexpr unsigned int shape_allpass = 4u;
+  static constexpr unsigned int shape_peak = 5u;
+  static constexpr unsigned int shape_lowshelf = 6u;
+  static constexpr unsigned int shape_highshelf = 7u;
+
+  static constexpr int lane_max = 8;
+
+  private:
+  static constexpr unsigned int swap_index_mask = 3u;
+  static constexpr unsigned int swap_update_bit = 4u;
+
+  protected:
+  struct param_t
+  {
+    unsigned int  shape;
+    float         frequency;      // cutoff or centre frequency, Hz
+    float         q;
+    float         gain;           // peak and shelf gain, dB
+  };
+
+  protected:
+  gate      m_input;
+  int       m_lane_count;
+  int       m_stage_count;
+  int       m_rate;               // rate the coefficients were computed for
+  param_t   m_param[lane_max];    // control thread: parameters as set
+  param_t   m_param_set[3][lane_max];
+  unsigned int m_param_back;      // control thread: set the parameters are published through
+  unsigned int m_param_front;     // render thread: set the coefficients were computed from
+  std::atomic<unsigned int> m_param_swap; // set in between the two, with the update bit set if it's newer than the front
+
+  protected:
+          void    set_update() noexcept;
+          bool    dsp_prepare() noexcept;
+  virtual void    dsp_update(int, const param_t&, float) noexcept = 0;
+
+  public:
+          filter(int, int) noexcept;
+          filter(const filter&) noexcept = delete;
+          filter(filter&&) noexcept = delete;
+  virtual ~filter();
+
+  virtual void    reset() noexcept = 0;
+
+          bool    set(int, unsigned int, float, float = 0.70710678f, float = 0.0f) noexcept;
+          bool    set_shape(int, unsigned int) noexcept;
+          bool    set_frequency(int, float) noexcept;
+          bool    set_q(int, float) noexcept;
+          bool    set_gain(int, float) noexcept;
+
+          gate&   get_input() noexcept;
+          int     get_lane_count() const noexcept;
+          int     get_stage_count() const noexcept;
+
+          filter& operator=(const filter&) noexcept = delete;
+          filter& operator=(filter&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
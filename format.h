@@ -25,21 +25,61 @@
 
 namespace dsp {
 
-/* format flags: [ - F F F  - - S S ]
+/* format flags: [ - F F F  L - S S ]
 */
 static constexpr unsigned int fmt_undef = 0;
 static constexpr unsigned int fmt_mode_bits = 0x70;
-static constexpr unsigned int fmt_size_bits = 0x02;
+static constexpr unsigned int fmt_size_bits = 0x03;
+static constexpr unsigned int fmt_planar = 0x08;          // channels are laid out one after the other instead of interleaved
 
-static constexpr unsigned int mode_pcm  = 0x10;           // PCM encoding; size bits indicate the number of channels (1..8)
+static constexpr unsigned int mode_pcm  = 0x10;           // PCM encoding; size bits hold the log2 of the number of channels (1..8)
 static constexpr unsigned int mode_apm  = 0x20;           // Amplitude/Phase encoding
 
 static constexpr unsigned int fmt_pcm   = mode_pcm;
 static constexpr unsigned int fmt_pcm_1 = fmt_pcm;        // PCM single channel
 static constexpr unsigned int fmt_pcm_2 = mode_pcm | 1;   // PCM 2 channels interleaved
 static constexpr unsigned int fmt_pcm_4 = mode_pcm | 2;   // PCM 4 channels interleaved
-static constexpr unsigned int fmt_pcm_8 = mode_pcm | 4;   // PCM 8 channels interleaved
+static constexpr unsigned int fmt_pcm_8 = mode_pcm | 3;   // PCM 8 channels interleaved
+static constexpr unsigned int fmt_pcm_2p = fmt_pcm_2 | fmt_planar;   // PCM 2 channels planar
+static constexpr unsigned int fmt_pcm_4p = fmt_pcm_4 | fmt_planar;   // PCM 4 channels planar
+static constexpr unsigned int fmt_pcm_8p = fmt_pcm_8 | fmt_planar;   // PCM 8 channels planar
 static constexpr unsigned int fmt_apm   = mode_apm | 1;
 
+/* fmt_get_sample_size()
+   number of values that make up a single sample frame in the given format
+*/
+constexpr int fmt_get_sample_size(unsigned int format) noexcept
+{
+      return 1 << (format & fmt_size_bits);
+}
+
+constexpr unsigned int fmt_get_mode(unsigned int format) noexcept
+{
+      return format & fmt_mode_bits;
+}
+
+/* fmt_is_planar()
+   planar formats keep each channel in its own contiguous, `memory_vector_block` aligned run within a vector
+*/
+constexpr bool fmt_is_planar(unsigned int format) noexcept
+{
+      return (format & fmt_planar) != 0;
+}
+
+/* fmt_is_valid()
+   check that the given format is one of the supported sample formats
+*/
+constexpr bool fmt_is_valid(unsigned int format) noexcept
+{
+      return (format == fmt_pcm_1) ||
+          (format == fmt_pcm_2) ||
+          (format == fmt_pcm_4) ||
+          (format == fmt_pcm_8) ||
+          (format == fmt_pcm_2p) ||
+          (format == fmt_pcm_4p) ||
+          (format == fmt_pcm_8p) ||
+          (format == fmt_apm);
+}
+
 /*namespace dsp*/ }
 #endif
@@ -0,0 +1,150 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "image.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dsp {
+
+/* img_get_hash()
+   32-bit FNV-1a over the given bytes
+*/
+std::uint32_t img_get_hash(const std::uint8_t* data, std::uint32_t size) noexcept
+{
+      std::uint32_t l_hash = 0x811c9dc5u;
+      for(std::uint32_t i_byte = 0; i_byte < size; i_byte++) {
+          l_hash ^= data[i_byte];
+          l_hash *= 0x01000193u;
+      }
+      return l_hash;
+}
+
+/* img_is_valid()
+   check the header of a program image against the host and the content hash against its payload
+*/
+bool  img_is_valid(const std::uint8_t* data, std::uint64_t size) noexcept
+{
+      img_head_t l_head;
+      if(size < sizeof(img_head_t)) {
+          return false;
+      }
+      std::memcpy(std::addressof(l_head), data, sizeof(l_head));
+      if(std::memcmp(l_head.id, "DSPX", 4) != 0) {
+          return false;
+      }
+      if((l_head.version != img_version) ||
+          (l_head.value_size != sizeof(fptype))) {
+          return false;
+      }
+      if(l_head.uniform_count > l_head.variable_count) {
+          return false;
+      }
+      std::uint64_t l_size =
+          l_head.argc * sizeof(img_arg_t) +
+          l_head.instruction_count * sizeof(img_micro_t) +
+          (l_head.variable_count - l_head.uniform_count) * sizeof(fptype);
+      if((l_head.size != l_size) ||
+          (size < sizeof(img_head_t) + l_size)) {
+          return false;
+      }
+      return img_get_hash(data + sizeof(img_head_t), l_head.size) == l_head.hash;
+}
+
+/* img_map()
+   map a program image from a cache file; the mapping is read only and shared with other processes loading the same file
+*/
+const std::uint8_t* img_map(const char* path, std::uint64_t& size) noexcept
+{
+      int         l_fd;
+      struct stat l_stat;
+      void*       l_map_ptr;
+      l_fd = open(path, O_RDONLY);
+      if(l_fd < 0) {
+          return nullptr;
+      }
+      if(fstat(l_fd, std::addressof(l_stat)) != 0) {
+          close(l_fd);
+          return nullptr;
+      }
+      if(l_stat.st_size < static_cast<off_t>(sizeof(img_head_t))) {
+          close(l_fd);
+          return nullptr;
+      }
+      l_map_ptr = mmap(nullptr, l_stat.st_size, PROT_READ, MAP_SHARED, l_fd, 0);
+      close(l_fd);
+      if(l_map_ptr == MAP_FAILED) {
+          printdbg("Failed to map program image `%s`.\n", __FILE__, __LINE__, path);
+          return nullptr;
+      }
+      size = l_stat.st_size;
+      return reinterpret_cast<const std::uint8_t*>(l_map_ptr);
+}
+
+void  img_unmap(const std::uint8_t* data, std::uint64_t size) noexcept
+{
+      munmap(const_cast<std::uint8_t*>(data), size);
+}
+
+/* img_write()
+   store a program image into a cache file; the image is written under a temporary name and renamed into place, so that
+   concurrent readers only ever map a complete image
+*/
+bool  img_write(const char* path, const std::uint8_t* data, std::uint64_t size) noexcept
+{
+      char    l_temp_path[4096];
+      int     l_fd;
+      bool    l_result = true;
+      if(std::snprintf(l_temp_path, sizeof(l_temp_path), "%s.%d", path, getpid()) >= static_cast<int>(sizeof(l_temp_path))) {
+          return false;
+      }
+      l_fd = open(l_temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if(l_fd < 0) {
+          printdbg("Failed to create program image `%s`.\n", __FILE__, __LINE__, path);
+          return false;
+      }
+      while(size > 0) {
+          ssize_t l_write_size = write(l_fd, data, size);
+          if(l_write_size <= 0) {
+              l_result = false;
+              break;
+          }
+          data += l_write_size;
+          size -= l_write_size;
+      }
+      if(close(l_fd) != 0) {
+          l_result = false;
+      }
+      if(l_result) {
+          if(rename(l_temp_path, path) == 0) {
+              return true;
+          }
+      }
+      unlink(l_temp_path);
+      return false;
+}
+
+/*namespace dsp*/ }
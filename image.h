@@ -0,0 +1,84 @@
+#ifndef dsp_image_h
+#define dsp_image_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include <cstdint>
+
+namespace dsp {
+
+/* img_*
+   relocatable program image: the compiled microcode of a core, its constant data registers and the code range of every
+   argument, stored independently of the width of the vector unit and of the addresses it was built at;
+   register operands are stored as register indices, data operands as data register indices, multi-byte fields
+   little-endian, which is assumed to match the host
+
+   [ img_head_t | img_arg_t x argc | img_micro_t x instruction_count | fptype x (variable_count - uniform_count) ]
+
+   the leading `uniform_count` data registers belong to uniforms and are rebound by the loader, the rest hold constants
+*/
+struct img_head_t
+{
+  char            id[4];              // "DSPX"
+  std::uint16_t   version;
+  std::uint16_t   value_size;         // sizeof(fptype) of the builder
+  std::uint16_t   argc;
+  std::uint16_t   variable_count;
+  std::uint16_t   uniform_count;
+  std::uint16_t   register_count;
+  std::uint16_t   instruction_count;
+  std::uint16_t   reserved;
+  std::uint32_t   hash;               // content hash of everything following the header
+  std::uint32_t   size;               // size of everything following the header, in bytes
+};
+
+struct img_arg_t
+{
+  std::uint16_t   code_head;
+  std::uint16_t   code_tail;
+};
+
+struct img_micro_t
+{
+  std::uint8_t    op_code;
+  std::uint8_t    op_dst;
+  std::uint8_t    op_src;
+  std::uint8_t    bits;               // bit_flags in the low nibble, then bit_const, bit_volatile, bit_halt, bit_return
+  std::int32_t    dst;
+  std::int32_t    src;
+  std::int32_t    src_a;
+};
+
+static constexpr std::uint16_t img_version = 1;
+
+        std::uint32_t img_get_hash(const std::uint8_t*, std::uint32_t) noexcept;
+        bool  img_is_valid(const std::uint8_t*, std::uint64_t) noexcept;
+const std::uint8_t* img_map(const char*, std::uint64_t&) noexcept;
+        void  img_unmap(const std::uint8_t*, std::uint64_t) noexcept;
+        bool  img_write(const char*, const std::uint8_t*, std::uint64_t) noexcept;
+
+static_assert(sizeof(img_head_t) == 28, "unexpected padding in img_head_t");
+static_assert(sizeof(img_arg_t) == 4, "unexpected padding in img_arg_t");
+static_assert(sizeof(img_micro_t) == 16, "unexpected padding in img_micro_t");
+
+/*namespace dsp*/ }
+#endif
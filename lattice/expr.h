@@ -65,9 +65,40 @@ struct op_neg: public statement<Lt>
   constexpr op_neg& operator=(op_neg&&) noexcept = default;
 };
 
+template<typename Lt, typename Rt>
+struct op_mul;
+
+/* is_product
+   products feeding an add or a sub are fused into a single fma/fms/fnma micro by the factory
+*/
+template<typename Xt>
+constexpr bool is_product = false;
+
+template<typename Lt, typename Rt>
+constexpr bool is_product<op_mul<Lt, Rt>> = true;
+
+/* get_fused_register_need()
+   registers used by an add or a sub once a product operand has been fused: the two factors and the remaining operand are
+   all live when the fused micro runs
+*/
+template<typename Lt, typename Rt>
+constexpr int get_fused_register_need() noexcept
+{
+      if constexpr (is_product<Lt>) {
+          return get_register_need<3>({decltype(Lt::lhs)::used_register_count, decltype(Lt::rhs)::used_register_count, Rt::used_register_count});
+      } else
+      if constexpr (is_product<Rt>) {
+          return get_register_need<3>({decltype(Rt::lhs)::used_register_count, decltype(Rt::rhs)::used_register_count, Lt::used_register_count});
+      } else
+          return statement<Lt, Rt>::used_register_count;
+}
+
 template<typename Lt, typename Rt>
 struct op_add: public statement<Lt, Rt>
 {
+  static constexpr int used_register_count = get_fused_register_need<Lt, Rt>();
+  static constexpr int used_instruction_count = statement<Lt, Rt>::used_instruction_count - ((is_product<Lt> || is_product<Rt>) ? 1 : 0);
+
   constexpr op_add(const Lt& l, const Rt& r) noexcept:
             statement<Lt, Rt>(l, r) {
   }
@@ -85,6 +116,9 @@ struct op_add: public statement<Lt, Rt>
 template<typename Lt, typename Rt>
 struct op_sub: public statement<Lt, Rt>
 {
+  static constexpr int used_register_count = get_fused_register_need<Lt, Rt>();
+  static constexpr int used_instruction_count = statement<Lt, Rt>::used_instruction_count - ((is_product<Lt> || is_product<Rt>) ? 1 : 0);
+
   constexpr op_sub(const Lt& l, const Rt& r) noexcept:
             statement<Lt, Rt>(l, r) {
   }
@@ -134,5 +168,226 @@ struct op_div: public statement<Lt, Rt>
   constexpr op_div& operator=(op_div&&) noexcept = default;
 };
 
+template<typename Lt, typename Rt>
+struct op_min: public statement<Lt, Rt>
+{
+  constexpr op_min(const Lt& l, const Rt& r) noexcept:
+            statement<Lt, Rt>(l, r) {
+  }
+  constexpr op_min(const op_min&) noexcept = default;
+  constexpr op_min(op_min&&) noexcept = default;
+  constexpr ~op_min() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_min;
+  }
+
+  constexpr op_min& operator=(const op_min&) noexcept = default;
+  constexpr op_min& operator=(op_min&&) noexcept = default;
+};
+
+template<typename Lt, typename Rt>
+struct op_max: public statement<Lt, Rt>
+{
+  constexpr op_max(const Lt& l, const Rt& r) noexcept:
+            statement<Lt, Rt>(l, r) {
+  }
+  constexpr op_max(const op_max&) noexcept = default;
+  constexpr op_max(op_max&&) noexcept = default;
+  constexpr ~op_max() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_max;
+  }
+
+  constexpr op_max& operator=(const op_max&) noexcept = default;
+  constexpr op_max& operator=(op_max&&) noexcept = default;
+};
+
+template<typename Lt>
+struct op_abs: public statement<Lt>
+{
+  constexpr op_abs(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_abs(const op_abs&) noexcept = default;
+  constexpr op_abs(op_abs&&) noexcept = default;
+  constexpr ~op_abs() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_abs;
+  }
+
+  constexpr op_abs& operator=(const op_abs&) noexcept = default;
+  constexpr op_abs& operator=(op_abs&&) noexcept = default;
+};
+
+template<typename Lt>
+struct op_sqrt: public statement<Lt>
+{
+  constexpr op_sqrt(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_sqrt(const op_sqrt&) noexcept = default;
+  constexpr op_sqrt(op_sqrt&&) noexcept = default;
+  constexpr ~op_sqrt() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_sqrt;
+  }
+
+  constexpr op_sqrt& operator=(const op_sqrt&) noexcept = default;
+  constexpr op_sqrt& operator=(op_sqrt&&) noexcept = default;
+};
+
+/* transcendental operations
+   the Tier parameter selects the accuracy of the polynomial approximation in the interpreter, see micro::tier_*
+*/
+template<typename Lt, unsigned int Tier = micro::tier_default>
+struct op_exp: public statement<Lt>
+{
+  static constexpr unsigned int tier = Tier;
+
+  constexpr op_exp(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_exp(const op_exp&) noexcept = default;
+  constexpr op_exp(op_exp&&) noexcept = default;
+  constexpr ~op_exp() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_exp;
+  }
+
+  constexpr op_exp& operator=(const op_exp&) noexcept = default;
+  constexpr op_exp& operator=(op_exp&&) noexcept = default;
+};
+
+template<typename Lt, unsigned int Tier = micro::tier_default>
+struct op_log: public statement<Lt>
+{
+  static constexpr unsigned int tier = Tier;
+
+  constexpr op_log(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_log(const op_log&) noexcept = default;
+  constexpr op_log(op_log&&) noexcept = default;
+  constexpr ~op_log() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_log;
+  }
+
+  constexpr op_log& operator=(const op_log&) noexcept = default;
+  constexpr op_log& operator=(op_log&&) noexcept = default;
+};
+
+template<typename Lt, unsigned int Tier = micro::tier_default>
+struct op_sin: public statement<Lt>
+{
+  static constexpr unsigned int tier = Tier;
+
+  constexpr op_sin(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_sin(const op_sin&) noexcept = default;
+  constexpr op_sin(op_sin&&) noexcept = default;
+  constexpr ~op_sin() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_sin;
+  }
+
+  constexpr op_sin& operator=(const op_sin&) noexcept = default;
+  constexpr op_sin& operator=(op_sin&&) noexcept = default;
+};
+
+template<typename Lt, unsigned int Tier = micro::tier_default>
+struct op_cos: public statement<Lt>
+{
+  static constexpr unsigned int tier = Tier;
+
+  constexpr op_cos(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_cos(const op_cos&) noexcept = default;
+  constexpr op_cos(op_cos&&) noexcept = default;
+  constexpr ~op_cos() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_cos;
+  }
+
+  constexpr op_cos& operator=(const op_cos&) noexcept = default;
+  constexpr op_cos& operator=(op_cos&&) noexcept = default;
+};
+
+template<typename Lt, unsigned int Tier = micro::tier_default>
+struct op_tanh: public statement<Lt>
+{
+  static constexpr unsigned int tier = Tier;
+
+  constexpr op_tanh(const Lt& l) noexcept:
+            statement<Lt>(l) {
+  }
+  constexpr op_tanh(const op_tanh&) noexcept = default;
+  constexpr op_tanh(op_tanh&&) noexcept = default;
+  constexpr ~op_tanh() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_tanh;
+  }
+
+  constexpr op_tanh& operator=(const op_tanh&) noexcept = default;
+  constexpr op_tanh& operator=(op_tanh&&) noexcept = default;
+};
+
+template<typename Lt, typename Rt, unsigned int Tier = micro::tier_default>
+struct op_pow: public statement<Lt, Rt>
+{
+  static constexpr unsigned int tier = Tier;
+
+  constexpr op_pow(const Lt& l, const Rt& r) noexcept:
+            statement<Lt, Rt>(l, r) {
+  }
+  constexpr op_pow(const op_pow&) noexcept = default;
+  constexpr op_pow(op_pow&&) noexcept = default;
+  constexpr ~op_pow() = default;
+
+  constexpr operator unsigned int() const noexcept {
+          return micro::op_code_pow;
+  }
+
+  constexpr op_pow& operator=(const op_pow&) noexcept = default;
+  constexpr op_pow& operator=(op_pow&&) noexcept = default;
+};
+
+/* op_select
+   <cond> > 0 ? <lhs> : <rhs>, evaluated branch free: all three operands are computed and blended through a bit mask
+*/
+template<typename Ct, typename Lt, typename Rt>
+struct op_select: public statement<Lt, Rt>
+{
+  Ct  cond;
+
+  public:
+  static constexpr int used_variable_count = Ct::used_variable_count + Lt::used_variable_count + Rt::used_variable_count;
+  static constexpr int used_register_count = get_register_need<3>({Ct::used_register_count, Lt::used_register_count, Rt::used_register_count});
+  static constexpr int used_instruction_count = Ct::used_instruction_count + Lt::used_instruction_count + Rt::used_instruction_count + 4;
+
+  public:
+  constexpr op_select(const Ct& c, const Lt& l, const Rt& r) noexcept:
+            statement<Lt, Rt>(l, r),
+            cond(c) {
+  }
+  constexpr op_select(const op_select&) noexcept = default;
+  constexpr op_select(op_select&&) noexcept = default;
+  constexpr ~op_select() = default;
+
+  constexpr op_select& operator=(const op_select&) noexcept = default;
+  constexpr op_select& operator=(op_select&&) noexcept = default;
+};
+
 /*namespace dsp*/ }
 #endif
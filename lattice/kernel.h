@@ -0,0 +1,274 @@
+#ifndef dsp_lattice_kernel_h
+#define dsp_lattice_kernel_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "primitive.h"
+#include "expr.h"
+#include <dsp/runtime.h>
+#include <dsp/constant.h>
+#include <dsp/uniform.h>
+#include <cstring>
+
+namespace dsp {
+
+/* kernel_eval()
+   evaluate a lattice expression natively into a register of fpu::pts lanes; the whole tree is instantiated at compile time
+   and produces the same values as the microcode the factory would build for it, including the fused multiply-add forms and
+   the accuracy tiers of the approximated operations
+*/
+inline void kernel_eval(fptype* dst, const constant& expr) noexcept
+{
+      fpu::reg_mov(dst, expr.get_value());
+}
+
+inline void kernel_eval(fptype* dst, const reference<uniform>& expr) noexcept
+{
+      std::memcpy(dst, static_cast<fptype*>(expr.lhs), fpu::pts * sizeof(fptype));
+}
+
+/* kernel_map()
+   evaluate <lhs> and apply a lane function to the result
+*/
+template<typename Lt, typename Ft>
+inline void kernel_map(fptype* dst, const Lt& lhs, Ft function) noexcept
+{
+      kernel_eval(dst, lhs);
+      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+          dst[i_lane] = function(dst[i_lane]);
+      }
+}
+
+/* kernel_zip()
+   evaluate <lhs> and <rhs> and apply a lane function to each pair of results
+*/
+template<typename Lt, typename Rt, typename Ft>
+inline void kernel_zip(fptype* dst, const Lt& lhs, const Rt& rhs, Ft function) noexcept
+{
+      fptype l_rhs[fpu::pts];
+      kernel_eval(dst, lhs);
+      kernel_eval(l_rhs, rhs);
+      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+          dst[i_lane] = function(dst[i_lane], l_rhs[i_lane]);
+      }
+}
+
+/* kernel_fuse()
+   evaluate <lhs> * <rhs> + <acc> with <acc> and the product scaled by the given signs
+*/
+template<typename Lt, typename Rt, typename At>
+inline void kernel_fuse(fptype* dst, const Lt& lhs, const Rt& rhs, const At& acc, fptype mul_sign, fptype acc_sign) noexcept
+{
+      fptype l_rhs[fpu::pts];
+      fptype l_acc[fpu::pts];
+      kernel_eval(dst, lhs);
+      kernel_eval(l_rhs, rhs);
+      kernel_eval(l_acc, acc);
+      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+          dst[i_lane] = rt_fma(mul_sign * dst[i_lane], l_rhs[i_lane], acc_sign * l_acc[i_lane]);
+      }
+}
+
+template<typename Lt>
+inline void kernel_eval(fptype* dst, const op_pos<Lt>& expr) noexcept
+{
+      kernel_eval(dst, expr.lhs);
+}
+
+template<typename Lt>
+inline void kernel_eval(fptype* dst, const op_neg<Lt>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return -x; });
+}
+
+template<typename Lt>
+inline void kernel_eval(fptype* dst, const op_abs<Lt>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return std::fabs(x); });
+}
+
+template<typename Lt>
+inline void kernel_eval(fptype* dst, const op_sqrt<Lt>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return std::sqrt(x); });
+}
+
+template<typename Lt, unsigned int Tier>
+inline void kernel_eval(fptype* dst, const op_exp<Lt, Tier>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return rt_exp<Tier>(x); });
+}
+
+template<typename Lt, unsigned int Tier>
+inline void kernel_eval(fptype* dst, const op_log<Lt, Tier>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return rt_log<Tier>(x); });
+}
+
+template<typename Lt, unsigned int Tier>
+inline void kernel_eval(fptype* dst, const op_sin<Lt, Tier>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return rt_sin<Tier>(x); });
+}
+
+template<typename Lt, unsigned int Tier>
+inline void kernel_eval(fptype* dst, const op_cos<Lt, Tier>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return rt_cos<Tier>(x); });
+}
+
+template<typename Lt, unsigned int Tier>
+inline void kernel_eval(fptype* dst, const op_tanh<Lt, Tier>& expr) noexcept
+{
+      kernel_map(dst, expr.lhs, [](fptype x) noexcept { return rt_tanh<Tier>(x); });
+}
+
+template<typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_add<Lt, Rt>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return x + y; });
+}
+
+template<typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_sub<Lt, Rt>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return x - y; });
+}
+
+template<typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_mul<Lt, Rt>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return x * y; });
+}
+
+template<typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_div<Lt, Rt>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return x / y; });
+}
+
+template<typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_min<Lt, Rt>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return y < x ? y : x; });
+}
+
+template<typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_max<Lt, Rt>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return y > x ? y : x; });
+}
+
+template<typename Lt, typename Rt, unsigned int Tier>
+inline void kernel_eval(fptype* dst, const op_pow<Lt, Rt, Tier>& expr) noexcept
+{
+      kernel_zip(dst, expr.lhs, expr.rhs, [](fptype x, fptype y) noexcept { return rt_pow<Tier>(x, y); });
+}
+
+/* <a> * <b> + <rhs>, <lhs> + <a> * <b>, <a> * <b> - <rhs>, <lhs> - <a> * <b>
+   fused in the same way factory::build() fuses them
+*/
+template<typename At, typename Bt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_add<op_mul<At, Bt>, Rt>& expr) noexcept
+{
+      kernel_fuse(dst, expr.lhs.lhs, expr.lhs.rhs, expr.rhs, 1, 1);
+}
+
+template<typename Lt, typename At, typename Bt>
+inline void kernel_eval(fptype* dst, const op_add<Lt, op_mul<At, Bt>>& expr) noexcept
+{
+      kernel_fuse(dst, expr.rhs.lhs, expr.rhs.rhs, expr.lhs, 1, 1);
+}
+
+template<typename At, typename Bt, typename Ct, typename Dt>
+inline void kernel_eval(fptype* dst, const op_add<op_mul<At, Bt>, op_mul<Ct, Dt>>& expr) noexcept
+{
+      kernel_fuse(dst, expr.lhs.lhs, expr.lhs.rhs, expr.rhs, 1, 1);
+}
+
+template<typename At, typename Bt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_sub<op_mul<At, Bt>, Rt>& expr) noexcept
+{
+      kernel_fuse(dst, expr.lhs.lhs, expr.lhs.rhs, expr.rhs, 1, -1);
+}
+
+template<typename Lt, typename At, typename Bt>
+inline void kernel_eval(fptype* dst, const op_sub<Lt, op_mul<At, Bt>>& expr) noexcept
+{
+      kernel_fuse(dst, expr.rhs.lhs, expr.rhs.rhs, expr.lhs, -1, 1);
+}
+
+template<typename At, typename Bt, typename Ct, typename Dt>
+inline void kernel_eval(fptype* dst, const op_sub<op_mul<At, Bt>, op_mul<Ct, Dt>>& expr) noexcept
+{
+      kernel_fuse(dst, expr.lhs.lhs, expr.lhs.rhs, expr.rhs, 1, -1);
+}
+
+template<typename Ct, typename Lt, typename Rt>
+inline void kernel_eval(fptype* dst, const op_select<Ct, Lt, Rt>& expr) noexcept
+{
+      fptype l_lhs[fpu::pts];
+      fptype l_rhs[fpu::pts];
+      kernel_eval(dst, expr.cond);
+      kernel_eval(l_lhs, expr.lhs);
+      kernel_eval(l_rhs, expr.rhs);
+      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+          dst[i_lane] = dst[i_lane] > 0 ? l_lhs[i_lane] : l_rhs[i_lane];
+      }
+}
+
+/* kernel_bind()
+   walk the leaves of a lattice expression and hand each uniform to the given binder
+*/
+template<typename Ft>
+inline void kernel_bind(const constant&, Ft&&) noexcept
+{
+}
+
+template<typename Ft>
+inline void kernel_bind(const reference<uniform>& expr, Ft&& bind) noexcept
+{
+      bind(expr.lhs);
+}
+
+template<typename Lt, typename Ft>
+inline void kernel_bind(const statement<Lt>& expr, Ft&& bind) noexcept
+{
+      kernel_bind(expr.lhs, bind);
+}
+
+template<typename Lt, typename Rt, typename Ft>
+inline void kernel_bind(const statement<Lt, Rt>& expr, Ft&& bind) noexcept
+{
+      kernel_bind(expr.lhs, bind);
+      kernel_bind(expr.rhs, bind);
+}
+
+template<typename Ct, typename Lt, typename Rt, typename Ft>
+inline void kernel_bind(const op_select<Ct, Lt, Rt>& expr, Ft&& bind) noexcept
+{
+      kernel_bind(expr.cond, bind);
+      kernel_bind(expr.lhs, bind);
+      kernel_bind(expr.rhs, bind);
+}
+
+/*namespace dsp*/ }
+#endif
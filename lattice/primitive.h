@@ -24,9 +24,47 @@
 #include <dsp.h>
 #include <dsp/config.h>
 #include <util.h>
+#include <array>
 
 namespace dsp {
 
+/* get_build_order()
+   order in which the operands of an operation are built: the operand that needs the most registers goes first, ties keep
+   their original order (Sethi-Ullman ordering)
+*/
+template<std::size_t N>
+constexpr std::array<int, N> get_build_order(const std::array<int, N>& need) noexcept
+{
+      std::array<int, N> l_order{};
+      for(int i_operand = 0; i_operand < static_cast<int>(N); i_operand++) {
+          int i_place = i_operand;
+          while((i_place > 0) && (need[l_order[i_place - 1]] < need[i_operand])) {
+              l_order[i_place] = l_order[i_place - 1];
+              i_place--;
+          }
+          l_order[i_place] = i_operand;
+      }
+      return l_order;
+}
+
+/* get_register_need()
+   number of registers needed to evaluate an operation whose operands need the given number of registers each, when the
+   operands are built in get_build_order() and every result is held until the operation consumes it in place
+*/
+template<std::size_t N>
+constexpr int get_register_need(const std::array<int, N>& need) noexcept
+{
+      std::array<int, N> l_order = get_build_order(need);
+      int l_result = 0;
+      for(int i_order = 0; i_order < static_cast<int>(N); i_order++) {
+          int l_need = need[l_order[i_order]] + i_order;
+          if(l_need > l_result) {
+              l_result = l_need;
+          }
+      }
+      return l_result;
+}
+
 struct null
 {
   static constexpr int used_variable_count = 0;
@@ -82,7 +120,7 @@ struct statement
 
   public:
   static constexpr int used_variable_count = Lt::used_variable_count + Rt::used_variable_count;
-  static constexpr int used_register_count = Lt::used_register_count + Rt::used_register_count + 1;
+  static constexpr int used_register_count = get_register_need<2>({Lt::used_register_count, Rt::used_register_count});
   static constexpr int used_instruction_count = Lt::used_instruction_count + Rt::used_instruction_count + 1;
 
   public:
@@ -115,7 +153,7 @@ struct statement<Lt, null>
 
   public:
   static constexpr int used_variable_count = Lt::used_variable_count;
-  static constexpr int used_register_count = Lt::used_register_count + 1;
+  static constexpr int used_register_count = Lt::used_register_count;
   static constexpr int used_instruction_count = Lt::used_instruction_count + 1;
 
   public:
@@ -20,15 +20,116 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "mmu.h"
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
 
 namespace dsp {
 
-      mmu::mmu() noexcept
+static thread_local mmu* s_current_mmu = nullptr;
+
+      mmu::mmu(std::size_t page_size) noexcept:
+      m_page_head(nullptr),
+      m_page_tail(nullptr),
+      m_page_size(page_size),
+      m_used_size(0),
+      m_mmu_prev(nullptr)
 {
 }
 
       mmu::~mmu()
 {
+      reset();
+}
+
+/* make_page()
+   allocate a new page able to hold at least `size` bytes and append it to the page list
+*/
+mmu::page_t* mmu::make_page(std::size_t size) noexcept
+{
+      std::size_t l_data_size = size > m_page_size ? size : m_page_size;
+      void*       l_page_ptr = malloc(sizeof(page_t) + alignof(std::max_align_t) + l_data_size);
+      if(l_page_ptr) {
+          auto l_page_base = reinterpret_cast<page_t*>(l_page_ptr);
+          l_page_base->page_next = nullptr;
+          l_page_base->data_size = alignof(std::max_align_t) + l_data_size;
+          l_page_base->data_used = 0;
+          if(m_page_tail) {
+              m_page_tail->page_next = l_page_base;
+          } else
+              m_page_head = l_page_base;
+          m_page_tail = l_page_base;
+          return l_page_base;
+      }
+      return nullptr;
+}
+
+/* acquire()
+   carve `size` bytes aligned to `align` out of the current page, starting a new page if it is exhausted
+*/
+void* mmu::acquire(std::size_t size, std::size_t align) noexcept
+{
+      page_t* l_page = m_page_tail;
+      for(int i_try = 0; i_try < 2; i_try++) {
+          if(l_page != nullptr) {
+              auto l_data_base = reinterpret_cast<std::uintptr_t>(l_page + 1);
+              auto l_data_ptr  = get_round_value<std::uintptr_t>(l_data_base + l_page->data_used, align);
+              if(l_data_ptr + size <= l_data_base + l_page->data_size) {
+                  l_page->data_used = l_data_ptr + size - l_data_base;
+                  m_used_size += size;
+                  return reinterpret_cast<void*>(l_data_ptr);
+              }
+          }
+          l_page = make_page(size + align);
+      }
+      return nullptr;
+}
+
+/* reset()
+   release all the storage handed out by the mmu at once
+*/
+void  mmu::reset() noexcept
+{
+      page_t* i_next;
+      page_t* i_page = m_page_head;
+      while(i_page != nullptr) {
+          i_next = i_page->page_next;
+          free(i_page);
+          i_page = i_next;
+      }
+      m_page_head = nullptr;
+      m_page_tail = nullptr;
+      m_used_size = 0;
+}
+
+/* enter()
+   make this mmu the one the cores built on the calling thread allocate their compiled storage from
+*/
+void  mmu::enter() noexcept
+{
+      m_mmu_prev = s_current_mmu;
+      s_current_mmu = this;
+}
+
+/* leave()
+   restore the mmu that was active on the calling thread before enter()
+*/
+void  mmu::leave() noexcept
+{
+      if(s_current_mmu == this) {
+          s_current_mmu = m_mmu_prev;
+          m_mmu_prev = nullptr;
+      }
+}
+
+mmu*  mmu::get_current() noexcept
+{
+      return s_current_mmu;
+}
+
+std::size_t mmu::get_used_size() const noexcept
+{
+      return m_used_size;
 }
 
 /*namespace dsp*/ }
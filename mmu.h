@@ -22,24 +22,54 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "dsp.h"
+#include "config.h"
+#include <cstddef>
 
 namespace dsp {
 
 /* mmu
-   dsp abstract memory manager unit
+   dsp abstract memory manager unit: arena the compiled storage of a graph is allocated from; while an mmu is active on a
+   thread, every core built on that thread carves its arguments, data registers and instructions out of the current page
+   in one contiguous block, so that consecutive nodes share cache lines and pages, and the storage of the whole graph is
+   released at once by reset() or by the destructor; the cores must not be used beyond that point
 */
 class mmu
 {
+  struct page_t
+  {
+    page_t*       page_next;
+    std::size_t   data_size;
+    std::size_t   data_used;
+  };
+
+  page_t*       m_page_head;
+  page_t*       m_page_tail;
+  std::size_t   m_page_size;
+  std::size_t   m_used_size;
+  mmu*          m_mmu_prev;           // mmu that was active on the thread before this one
+
+  private:
+          page_t* make_page(std::size_t) noexcept;
+
   public:
-          mmu() noexcept;
+          mmu(std::size_t = memory_code_page) noexcept;
           mmu(const mmu&) noexcept = delete;
           mmu(mmu&&) noexcept = delete;
           ~mmu();
+
+          void* acquire(std::size_t, std::size_t) noexcept;
+          void  reset() noexcept;
+
+          void  enter() noexcept;
+          void  leave() noexcept;
+  static  mmu*  get_current() noexcept;
+
+          std::size_t get_used_size() const noexcept;
+
           mmu&  swap(mmu&) = delete;
           mmu&  operator=(const mmu&) noexcept = delete;
           mmu&  operator=(mmu&&) noexcept = delete;
 };
 
-
 /*namespace dsp*/ }
 #endif
@@ -0,0 +1,330 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "oscillator.h"
+#include <cmath>
+#include <cstring>
+
+namespace dsp {
+
+/* osc_blep()
+   polynomial band limited step residual around a discontinuity at phase 0, for a phase `t` advancing by `dt` per sample
+*/
+static inline fptype osc_blep(fptype t, fptype dt) noexcept
+{
+      if(t < dt) {
+          t = t / dt;
+          return t + t - t * t - 1.0f;
+      } else
+      if(t > 1.0f - dt) {
+          t = (t - 1.0f) / dt;
+          return t * t + t + t + 1.0f;
+      }
+      return 0.0f;
+}
+
+/* osc_phase()
+   fractional part of the phase `i` samples into the render pass; computed in double precision from the phase at the
+   start of the pass rather than accumulated, so that it carries no rounding from one sample to the next
+*/
+static inline fptype osc_phase(double phase, double increment, int i) noexcept
+{
+      double l_t = phase + increment * i;
+      double l_f = l_t - static_cast<int>(l_t);
+      if(l_f < 0.0) {
+          l_f += 1.0;
+      }
+      // the narrowing may round up onto the next cycle
+      return static_cast<fptype>(l_f) < 1.0f ? static_cast<fptype>(l_f) : 0.0f;
+}
+
+      oscillator::oscillator() noexcept:
+      oscillator(1)
+{
+}
+
+      oscillator::oscillator(int voices) noexcept:
+      core(o_none),
+      m_voice_count(0),
+      m_data(nullptr),
+      m_param(nullptr),
+      m_param_set{nullptr, nullptr, nullptr},
+      m_param_back(0u),
+      m_param_front(2u),
+      m_param_swap(1u),
+      m_phase(nullptr),
+      m_phase_serial(nullptr),
+      m_table(nullptr),
+      m_sine(nullptr)
+{
+      set_sample_format(fmt_pcm_1);
+      if(voices > 0) {
+          std::size_t l_size = voices * (sizeof(param_t) * 4 + sizeof(double) + sizeof(wavetable*) + sizeof(unsigned int));
+          m_data = malloc(l_size);
+          m_sine = wavetable::make_sine();
+          if((m_data != nullptr) &&
+              (m_sine != nullptr)) {
+              m_param = reinterpret_cast<param_t*>(m_data);
+              for(int i_set = 0; i_set < 3; i_set++) {
+                  m_param_set[i_set] = m_param + voices * (i_set + 1);
+              }
+              m_phase = reinterpret_cast<double*>(m_param + voices * 4);
+              m_table = reinterpret_cast<wavetable**>(m_phase + voices);
+              m_phase_serial = reinterpret_cast<unsigned int*>(m_table + voices);
+              m_voice_count = voices;
+              for(int i_voice = 0; i_voice < voices; i_voice++) {
+                  m_param[i_voice].phase = 0.0;
+                  m_param[i_voice].phase_serial = 0u;
+                  m_param[i_voice].shape = shape_sine;
+                  m_param[i_voice].frequency = 0.0f;
+                  m_param[i_voice].amplitude = 0.0f;
+                  m_phase[i_voice] = 0.0;
+                  m_phase_serial[i_voice] = 0u;
+                  m_table[i_voice] = nullptr;
+              }
+              for(int i_set = 0; i_set < 3; i_set++) {
+                  std::memcpy(m_param_set[i_set], m_param, voices * sizeof(param_t));
+              }
+          } else
+              dispose();
+      }
+}
+
+      oscillator::~oscillator()
+{
+      dispose();
+}
+
+bool  oscillator::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      double  l_rate = dsp_get_sample_rate();
+      fptype* l_output_ptr = dsp_get_return_vector();
+      if(dsp_get_sample_size() != 1) {
+          return false;
+      }
+      if((op & op_render_additive) == 0) {
+          pcm_clr(l_output_ptr, l_frames);
+      }
+      if(m_param_swap.load(std::memory_order_relaxed) & swap_update_bit) {
+          // newer parameters were published: take the middle set over as the front one
+          m_param_front = m_param_swap.exchange(m_param_front, std::memory_order_acq_rel) & swap_index_mask;
+      }
+      for(int i_voice = 0; i_voice < m_voice_count; i_voice++) {
+          const param_t& l_param = m_param_set[m_param_front][i_voice];
+          if(l_param.phase_serial != m_phase_serial[i_voice]) {
+              m_phase[i_voice] = l_param.phase;
+              m_phase_serial[i_voice] = l_param.phase_serial;
+          }
+          fptype  l_amplitude = l_param.amplitude;
+          double  l_phase = m_phase[i_voice];
+          double  l_increment = l_param.frequency / l_rate;
+          if(l_amplitude != 0.0f) {
+              switch(l_param.shape) {
+                  case shape_saw: {
+                      fptype l_dt = std::abs(l_increment);
+                      for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+                          fptype l_t = osc_phase(l_phase, l_increment, i_frame);
+                          fptype l_y = l_t + l_t - 1.0f - osc_blep(l_t, l_dt);
+                          l_output_ptr[i_frame] += l_y * l_amplitude;
+                      }
+                      break;
+                  }
+                  case shape_square: {
+                      fptype l_dt = std::abs(l_increment);
+                      for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+                          fptype l_t = osc_phase(l_phase, l_increment, i_frame);
+                          fptype l_u = l_t + 0.5f;
+                          if(l_u >= 1.0f) {
+                              l_u -= 1.0f;
+                          }
+                          fptype l_y = l_t < 0.5f ? 1.0f : -1.0f;
+                          l_y += osc_blep(l_t, l_dt) - osc_blep(l_u, l_dt);
+                          l_output_ptr[i_frame] += l_y * l_amplitude;
+                      }
+                      break;
+                  }
+                  case shape_sine:
+                  case shape_table: {
+                      wavetable*    l_table = m_table[i_voice];
+                      if((l_table == nullptr) ||
+                          (l_param.shape == shape_sine)) {
+                          l_table = m_sine;
+                      }
+                      const fptype* l_level = l_table->get_level(l_increment);
+                      for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+                          fptype l_x = osc_phase(l_phase, l_increment, i_frame) * wavetable_size;
+                          int    l_index = static_cast<int>(l_x);
+                          fptype l_a = l_level[l_index];
+                          fptype l_b = l_level[l_index + 1];
+                          l_output_ptr[i_frame] += (l_a + (l_b - l_a) * (l_x - l_index)) * l_amplitude;
+                      }
+                      break;
+                  }
+              }
+          }
+          l_phase += l_increment * l_frames;
+          m_phase[i_voice] = l_phase - std::floor(l_phase);
+      }
+      return true;
+}
+
+/* set_update()
+   control thread: publish the parameters of all voices to the render thread; the back set is filled and swapped with the
+   middle one, which it replaces as the newest
+*/
+void  oscillator::set_update() noexcept
+{
+      std::memcpy(m_param_set[m_param_back], m_param, m_voice_count * sizeof(param_t));
+      m_param_back = m_param_swap.exchange(m_param_back | swap_update_bit, std::memory_order_acq_rel) & swap_index_mask;
+}
+
+/* set()
+   set the shape, frequency (Hz) and amplitude of a voice
+*/
+bool  oscillator::set(int voice, unsigned int shape, float frequency, float amplitude) noexcept
+{
+      if((voice >= 0) &&
+          (voice < m_voice_count) &&
+          (shape <= shape_table)) {
+          m_param[voice].shape = shape;
+          m_param[voice].frequency = frequency;
+          m_param[voice].amplitude = amplitude;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  oscillator::set_shape(int voice, unsigned int value) noexcept
+{
+      if((voice >= 0) &&
+          (voice < m_voice_count) &&
+          (value <= shape_table)) {
+          m_param[voice].shape = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  oscillator::set_frequency(int voice, float value) noexcept
+{
+      if((voice >= 0) &&
+          (voice < m_voice_count)) {
+          m_param[voice].frequency = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+bool  oscillator::set_amplitude(int voice, float value) noexcept
+{
+      if((voice >= 0) &&
+          (voice < m_voice_count)) {
+          m_param[voice].amplitude = value;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+/* set_phase()
+   set the phase of a voice, in cycles; the voice restarts from it at the start of the next render pass
+*/
+bool  oscillator::set_phase(int voice, double value) noexcept
+{
+      if((voice >= 0) &&
+          (voice < m_voice_count)) {
+          m_param[voice].phase = value - std::floor(value);
+          m_param[voice].phase_serial++;
+          set_update();
+          return true;
+      }
+      return false;
+}
+
+/* set_table()
+   have a voice play the given wavetable when its shape is `shape_table`; the oscillator holds a reference to the table
+   for as long as it uses it; not to be called while the node is being rendered
+*/
+bool  oscillator::set_table(int voice, wavetable* table) noexcept
+{
+      if((voice >= 0) &&
+          (voice < m_voice_count)) {
+          if(table != nullptr) {
+              table->acquire();
+          }
+          if(m_table[voice] != nullptr) {
+              m_table[voice]->release();
+          }
+          m_table[voice] = table;
+          return true;
+      }
+      return false;
+}
+
+/* reset()
+   bring the phase of all the voices back to 0, at the start of the next render pass
+*/
+void  oscillator::reset() noexcept
+{
+      if(m_voice_count > 0) {
+          for(int i_voice = 0; i_voice < m_voice_count; i_voice++) {
+              m_param[i_voice].phase = 0.0;
+              m_param[i_voice].phase_serial++;
+          }
+          set_update();
+      }
+}
+
+void  oscillator::dispose() noexcept
+{
+      for(int i_voice = 0; i_voice < m_voice_count; i_voice++) {
+          if(m_table[i_voice] != nullptr) {
+              m_table[i_voice]->release();
+          }
+      }
+      if(m_sine != nullptr) {
+          m_sine->release();
+          m_sine = nullptr;
+      }
+      free(m_data);
+      m_data = nullptr;
+      m_param = nullptr;
+      m_phase = nullptr;
+      m_phase_serial = nullptr;
+      m_table = nullptr;
+      m_voice_count = 0;
+}
+
+int   oscillator::get_voice_count() const noexcept
+{
+      return m_voice_count;
+}
+
+bool  oscillator::is_valid() const noexcept
+{
+      return m_voice_count > 0;
+}
+
+/*namespace dsp*/ }
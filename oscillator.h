@@ -0,0 +1,106 @@
+#ifndef dsp_oscillator_h
+#define dsp_oscillator_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include "wavetable.h"
+#include <atomic>
+
+namespace dsp {
+
+/* oscillator
+   bank of free running oscillators, summed onto a single channel: band limited saw and square waves (PolyBLEP), sines and
+   mip-mapped wavetables; each voice keeps its phase in double precision, such that long running or very low frequency
+   voices don't drift, while the per-frame work runs in single precision along the whole render pass, a voice at a time;
+   the parameters of all voices travel from the control thread to the render thread as a whole, through a triple buffer
+   (as with filter), and a phase set from the control thread takes effect at the start of the next render pass
+*/
+class oscillator: public core
+{
+  public:
+  static constexpr unsigned int shape_sine = 0u;
+  static constexpr unsigned int shape_saw = 1u;
+  static constexpr unsigned int shape_square = 2u;
+  static constexpr unsigned int shape_table = 3u;
+
+  private:
+  static constexpr unsigned int swap_index_mask = 3u;
+  static constexpr unsigned int swap_update_bit = 4u;
+
+  /* param_t
+     voice parameters; the phase is only applied when `phase_serial` changes, such that each call to set_phase() restarts
+     the voice once
+  */
+  struct param_t
+  {
+    double        phase;
+    unsigned int  phase_serial;
+    unsigned int  shape;
+    float         frequency;
+    float         amplitude;
+  };
+
+  private:
+  int           m_voice_count;
+  void*         m_data;
+  param_t*      m_param;          // control thread: parameters as set
+  param_t*      m_param_set[3];
+  unsigned int  m_param_back;     // control thread: set the parameters are published through
+  unsigned int  m_param_front;    // render thread: set in use
+  std::atomic<unsigned int> m_param_swap; // set in between the two, with the update bit set if it's newer than the front
+  double*       m_phase;          // render thread: running phase, in cycles
+  unsigned int* m_phase_serial;   // render thread: serial of the last phase applied
+  wavetable**   m_table;
+  wavetable*    m_sine;
+
+  private:
+          void    set_update() noexcept;
+
+  protected:
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          oscillator() noexcept;
+          oscillator(int) noexcept;
+          oscillator(const oscillator&) noexcept = delete;
+          oscillator(oscillator&&) noexcept = delete;
+  virtual ~oscillator();
+
+          bool    set(int, unsigned int, float, float = 1.0f) noexcept;
+          bool    set_shape(int, unsigned int) noexcept;
+          bool    set_frequency(int, float) noexcept;
+          bool    set_amplitude(int, float) noexcept;
+          bool    set_phase(int, double) noexcept;
+          bool    set_table(int, wavetable*) noexcept;
+          void    reset() noexcept;
+          void    dispose() noexcept;
+
+          int     get_voice_count() const noexcept;
+          bool    is_valid() const noexcept;
+
+          oscillator& operator=(const oscillator&) noexcept = delete;
+          oscillator& operator=(oscillator&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
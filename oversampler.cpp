@@ -0,0 +1,256 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "oversampler.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace dsp {
+
+/* oversampler_history_size
+   number of past inputs each decimator stage has to keep around
+*/
+static constexpr int oversampler_history_size = oversampler_kernel_size * 4 - 2;
+
+      oversampler::oversampler() noexcept:
+      oversampler(2)
+{
+}
+
+      oversampler::oversampler(int factor) noexcept:
+      core(o_none),
+      m_input(this),
+      m_factor(1),
+      m_stage_count(0),
+      m_channel_count(0),
+      m_state(nullptr),
+      m_work(nullptr),
+      m_work_size(0)
+{
+      // kaiser windowed half-band kernel: only the centre tap and the odd taps around it are non-zero
+      double l_beta = 8.0;
+      double l_span = oversampler_kernel_size * 2;
+      double l_sum  = 0.0;
+      for(int i_tap = 0; i_tap < oversampler_kernel_size; i_tap++) {
+          double l_t = i_tap * 2 + 1;
+          double l_r = l_t / l_span;
+          double l_w = std::cyl_bessel_i(0.0, l_beta * std::sqrt(1.0 - l_r * l_r)) / std::cyl_bessel_i(0.0, l_beta);
+          double l_h = l_w / (std::numbers::pi * l_t);
+          if(i_tap & 1) {
+              l_h = -l_h;
+          }
+          m_kernel[i_tap] = l_h;
+          l_sum += l_h;
+      }
+      // unity gain at DC
+      for(int i_tap = 0; i_tap < oversampler_kernel_size; i_tap++) {
+          m_kernel[i_tap] *= 0.25 / l_sum;
+      }
+      set_factor(factor);
+}
+
+      oversampler::~oversampler()
+{
+      dispose();
+}
+
+/* dsp_reserve()
+   make sure the stage history is set up for the given number of channels and the work memory is large enough for an input
+   of `frames` frames
+*/
+bool  oversampler::dsp_reserve(int channels, int frames) noexcept
+{
+      if(channels != m_channel_count) {
+          auto p_state = reinterpret_cast<fptype*>(malloc(m_stage_count * channels * oversampler_history_size * sizeof(fptype)));
+          if(p_state == nullptr) {
+              return false;
+          }
+          std::memset(p_state, 0, m_stage_count * channels * oversampler_history_size * sizeof(fptype));
+          free(m_state);
+          m_state = p_state;
+          m_channel_count = channels;
+      }
+      int l_work_size = (oversampler_history_size + frames) * 2;
+      if(l_work_size > m_work_size) {
+          auto p_work = reinterpret_cast<fptype*>(malloc(l_work_size * sizeof(fptype)));
+          if(p_work == nullptr) {
+              return false;
+          }
+          free(m_work);
+          m_work = p_work;
+          m_work_size = l_work_size;
+      }
+      return true;
+}
+
+/* dsp_decimate()
+   halve the rate of `frames` inputs, which follow `oversampler_history_size` free slots in `sp` that receive the history
+   of the stage from `state`; the outputs are written onto `dp`, and the number of outputs is returned
+*/
+int   oversampler::dsp_decimate(fptype* dp, fptype* sp, fptype* state, int frames) noexcept
+{
+      constexpr int l_centre = oversampler_history_size / 2;
+      std::memcpy(sp, state, oversampler_history_size * sizeof(fptype));
+      const fptype* p_x = sp + oversampler_history_size;
+      int l_count = frames / 2;
+      for(int i_frame = 0; i_frame < l_count; i_frame++) {
+          const fptype* p_c = p_x + i_frame * 2 + 1 - l_centre;
+          fptype  l_sum = p_c[0] * 0.5f;
+          for(int i_tap = 0; i_tap < oversampler_kernel_size; i_tap++) {
+              int l_t = i_tap * 2 + 1;
+              l_sum += m_kernel[i_tap] * (p_c[-l_t] + p_c[l_t]);
+          }
+          dp[i_frame] = l_sum;
+      }
+      std::memcpy(state, sp + frames, oversampler_history_size * sizeof(fptype));
+      return l_count;
+}
+
+bool  oversampler::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      int     l_channels = dsp_get_sample_size();
+      int     l_stride = dsp_get_channel_stride();
+      int     l_input_frames = l_frames * m_factor;
+      int     l_input_stride = 0;
+      fptype* l_input_ptr = m_input.get_return_vector();
+      fptype* l_output_ptr = dsp_get_return_vector();
+      if(l_stride > 0) {
+          l_input_stride = get_round_value(l_input_frames, memory_vector_block);
+      }
+      if((l_input_ptr == nullptr) ||
+          (dsp_reserve(l_channels, l_input_frames) == false)) {
+          if((op & op_render_additive) == 0) {
+              pcm_clr(l_output_ptr, dsp_get_vector_size());
+          }
+          return l_input_ptr == nullptr;
+      }
+      for(int i_channel = 0; i_channel < l_channels; i_channel++) {
+          fptype* p_src = m_work;
+          fptype* p_dst = m_work + oversampler_history_size + l_input_frames;
+          int     l_count = l_input_frames;
+          // gather the channel
+          if(l_input_stride > 0) {
+              std::memcpy(p_src + oversampler_history_size, l_input_ptr + i_channel * l_input_stride, l_count * sizeof(fptype));
+          } else
+          if(true) {
+              fptype* p_input = l_input_ptr + i_channel;
+              for(int i_frame = 0; i_frame < l_count; i_frame++) {
+                  p_src[oversampler_history_size + i_frame] = p_input[i_frame * l_channels];
+              }
+          }
+          // run it down the stages, an octave at a time
+          for(int i_stage = 0; i_stage < m_stage_count; i_stage++) {
+              fptype* p_state = m_state + (i_stage * l_channels + i_channel) * oversampler_history_size;
+              l_count = dsp_decimate(p_dst + oversampler_history_size, p_src, p_state, l_count);
+              std::swap(p_src, p_dst);
+          }
+          // scatter onto the output
+          fptype* p_result = p_src + oversampler_history_size;
+          fptype* p_output;
+          int     l_step;
+          if(l_stride > 0) {
+              p_output = l_output_ptr + i_channel * l_stride;
+              l_step = 1;
+          } else
+          if(true) {
+              p_output = l_output_ptr + i_channel;
+              l_step = l_channels;
+          }
+          if(op & op_render_additive) {
+              for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+                  p_output[i_frame * l_step] += p_result[i_frame];
+              }
+          } else
+          if(true) {
+              for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+                  p_output[i_frame * l_step] = p_result[i_frame];
+              }
+          }
+      }
+      return true;
+}
+
+/* reset()
+   clear the history of the decimators
+*/
+void  oversampler::reset() noexcept
+{
+      if(m_state != nullptr) {
+          std::memset(m_state, 0, m_stage_count * m_channel_count * oversampler_history_size * sizeof(fptype));
+      }
+}
+
+void  oversampler::dispose() noexcept
+{
+      free(m_state);
+      free(m_work);
+      m_state = nullptr;
+      m_work = nullptr;
+      m_work_size = 0;
+      m_channel_count = 0;
+}
+
+gate& oversampler::get_input() noexcept
+{
+      return m_input;
+}
+
+int   oversampler::get_factor() const noexcept
+{
+      return m_factor;
+}
+
+/* set_factor()
+   set the oversampling factor: 1 (bypass), 2, 4 or 8; not to be called while the node is being rendered
+*/
+bool  oversampler::set_factor(int value) noexcept
+{
+      if((value >= 1) &&
+          (value <= 8) &&
+          std::has_single_bit(static_cast<unsigned int>(value))) {
+          if(value != m_factor) {
+              dispose();
+              m_factor = value;
+              m_stage_count = std::countr_zero(static_cast<unsigned int>(value));
+              set_input_factor(value);
+          }
+          return true;
+      }
+      return false;
+}
+
+/* get_latency()
+   delay introduced by the decimators, in frames at the rate of the node; output `i` of a stage is centred on input
+   `2 * i + 1 - oversampler_history_size / 2` (see dsp_decimate()), i.e. `oversampler_history_size / 2 - 1` inputs back
+*/
+float oversampler::get_latency() const noexcept
+{
+      float l_latency = 0.0f;
+      for(int i_stage = 0; i_stage < m_stage_count; i_stage++) {
+          l_latency = (l_latency + oversampler_history_size / 2 - 1) * 0.5f;
+      }
+      return l_latency;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,72 @@
+#ifndef dsp_oversampler_h
+#define dsp_oversampler_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "config.h"
+#include "core.h"
+
+namespace dsp {
+
+/* oversampler
+   runs the subtree attached to its input at 2, 4 or 8 times the rate of the calling branch and brings the result back
+   down through a cascade of half-band FIR decimators, one per octave; nodes within the subtree inherit the raised rate,
+   nodes that declare a rate of their own are brought up to it by the gate resamplers; meant to keep nonlinear stages
+   (saturators, waveshapers) from aliasing without having to run the whole graph at the higher rate
+*/
+class oversampler: public core
+{
+  gate      m_input;
+  int       m_factor;
+  int       m_stage_count;
+  int       m_channel_count;
+  fptype    m_kernel[oversampler_kernel_size];  // odd taps of the half-band kernel, from the centre outwards
+  fptype*   m_state;          // last inputs of each stage, for each channel
+  fptype*   m_work;
+  int       m_work_size;
+
+  protected:
+          bool    dsp_reserve(int, int) noexcept;
+          int     dsp_decimate(fptype*, fptype*, fptype*, int) noexcept;
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          oversampler() noexcept;
+          oversampler(int) noexcept;
+          oversampler(const oversampler&) noexcept = delete;
+          oversampler(oversampler&&) noexcept = delete;
+  virtual ~oversampler();
+
+          void    reset() noexcept;
+          void    dispose() noexcept;
+
+          gate&   get_input() noexcept;
+          int     get_factor() const noexcept;
+          bool    set_factor(int) noexcept;
+          float   get_latency() const noexcept;
+
+          oversampler& operator=(const oversampler&) noexcept = delete;
+          oversampler& operator=(oversampler&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
@@ -0,0 +1,359 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "player.h"
+#include "streamer.h"
+
+namespace dsp {
+
+      player::player() noexcept:
+      core(o_none),
+      m_map_ptr(nullptr),
+      m_map_size(0u),
+      m_info(),
+      m_head_ptr(nullptr),
+      m_head_frames(0),
+      m_mix_ptr(nullptr),
+      m_voice_ptr(nullptr),
+      m_voice_count(0),
+      m_streamer(nullptr),
+      m_player_next(nullptr),
+      m_underrun_count(0u)
+{
+}
+
+      player::~player()
+{
+      close();
+}
+
+/* dsp_fetch()
+   streaming thread: acknowledge new voice commands and top up the rings of the playing voices, decoding through the given
+   block; returns true if any frames were queued or commands acknowledged
+*/
+bool  player::dsp_fetch(fptype* block, int size) noexcept
+{
+      bool  l_progress = false;
+      const std::uint8_t* l_data_ptr = m_map_ptr + m_info.data_offset;
+      int   l_block_frames = size / m_info.channels;
+      for(int i_voice = 0; i_voice < m_voice_count; i_voice++) {
+          voice_t&     l_voice = m_voice_ptr[i_voice];
+          unsigned int l_command = l_voice.command.load(std::memory_order_acquire);
+          if(l_command != l_voice.fetch_command) {
+              l_voice.fetch_command = l_command;
+              l_voice.fetch_index = m_head_frames;
+              l_voice.ack_mark.store(l_voice.stream.get_write_mark(), std::memory_order_relaxed);
+              l_voice.ack_command.store(l_command, std::memory_order_release);
+              l_progress = true;
+          }
+          if(l_command & cmd_play) {
+              while(l_voice.fetch_index < m_info.frame_count) {
+                  std::uint64_t l_frames_left = m_info.frame_count - l_voice.fetch_index;
+                  int  l_frames = l_frames_left < static_cast<std::uint64_t>(l_block_frames) ? static_cast<int>(l_frames_left) : l_block_frames;
+                  if((l_frames == 0) ||
+                      (l_voice.stream.get_write_size() < l_frames * m_info.channels)) {
+                      break;
+                  }
+                  riff_decode(
+                      block,
+                      m_info.channels,
+                      l_data_ptr + l_voice.fetch_index * m_info.frame_size,
+                      m_info.channels,
+                      m_info.encoding,
+                      l_frames
+                  );
+                  l_voice.stream.write(block, l_frames * m_info.channels);
+                  l_voice.fetch_index += l_frames;
+                  l_progress = true;
+                  // don't keep filling the ring with frames the voice has been retriggered away from
+                  if(l_voice.command.load(std::memory_order_relaxed) != l_command) {
+                      break;
+                  }
+              }
+          }
+      }
+      return l_progress;
+}
+
+/* dsp_mix()
+   add `frames` frames of interleaved sample data onto the output, mapping the channels of the sample onto the ones of the
+   branch
+*/
+void  player::dsp_mix(fptype* dp, int dp_channels, int dp_stride, fptype* sp, int frames) noexcept
+{
+      pcm_map(dp, dp_channels, dp_stride, sp, m_info.channels, 0, frames, true);
+}
+
+/* render()
+   mix the playing voices: a voice starts out of the resident head and then carries on from its ring, once the streamer
+   has acknowledged the command that started it
+*/
+bool  player::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      int     l_channels = dsp_get_sample_size();
+      int     l_stride = dsp_get_channel_stride();
+      int     l_step = l_stride ? 1 : l_channels;
+      fptype* l_data_ptr = dsp_get_return_vector();
+      bool    l_stream_bit = false;
+      if((op & op_render_additive) == 0) {
+          pcm_clr(l_data_ptr, dsp_get_vector_size());
+      }
+      for(int i_voice = 0; i_voice < m_voice_count; i_voice++) {
+          voice_t&     l_voice = m_voice_ptr[i_voice];
+          unsigned int l_command = l_voice.command.load(std::memory_order_acquire);
+          if(l_command != l_voice.play_command) {
+              l_voice.play_command = l_command;
+              l_voice.play_index = 0u;
+              l_voice.sync_bit = false;
+          }
+          if(l_command & cmd_play) {
+              fptype* p_data = l_data_ptr;
+              int     l_frames_left = l_frames;
+              if(l_voice.sync_bit == false) {
+                  if(l_voice.ack_command.load(std::memory_order_acquire) == l_command) {
+                      l_voice.stream.clear(l_voice.ack_mark.load(std::memory_order_relaxed));
+                      l_voice.sync_bit = true;
+                  }
+              }
+              if(l_voice.play_index + l_frames_left > m_info.frame_count) {
+                  l_frames_left = m_info.frame_count - l_voice.play_index;
+              }
+              if(l_voice.play_index < static_cast<std::uint64_t>(m_head_frames)) {
+                  int l_head_frames = m_head_frames - l_voice.play_index;
+                  if(l_head_frames > l_frames_left) {
+                      l_head_frames = l_frames_left;
+                  }
+                  dsp_mix(p_data, l_channels, l_stride, m_head_ptr + l_voice.play_index * m_info.channels, l_head_frames);
+                  p_data += l_head_frames * l_step;
+                  l_voice.play_index += l_head_frames;
+                  l_frames_left -= l_head_frames;
+              }
+              if(l_voice.play_index < m_info.frame_count) {
+                  l_stream_bit = true;
+              }
+              while(l_frames_left > 0) {
+                  int l_read = 0;
+                  if(l_voice.sync_bit) {
+                      int l_read_frames = l_frames_left < streamer_block_frames ? l_frames_left : streamer_block_frames;
+                      l_read = l_voice.stream.read(m_mix_ptr, l_read_frames * m_info.channels) / m_info.channels;
+                  }
+                  if(l_read == 0) {
+                      m_underrun_count.fetch_add(1u, std::memory_order_relaxed);
+                      break;
+                  }
+                  dsp_mix(p_data, l_channels, l_stride, m_mix_ptr, l_read);
+                  p_data += l_read * l_step;
+                  l_voice.play_index += l_read;
+                  l_frames_left -= l_read;
+              }
+              if(l_voice.play_index >= m_info.frame_count) {
+                  // the sample is over: drop the play bit from the command, unless the voice was retriggered meanwhile,
+                  // such that the voice reads as stopped and the streamer leaves it alone
+                  unsigned int l_stop_command = l_command & ~cmd_play;
+                  if(l_voice.command.compare_exchange_strong(l_command, l_stop_command, std::memory_order_release, std::memory_order_relaxed)) {
+                      l_voice.play_command = l_stop_command;
+                  }
+              }
+          }
+      }
+      if(l_stream_bit) {
+          if(m_streamer != nullptr) {
+              m_streamer->wake();
+          }
+      }
+      return true;
+}
+
+/* open()
+   map a RIFF/WAVE or RF64 sample file, decode its first `head_frames` frames into resident memory and set up `voices`
+   voices with a ring of `stream_frames` frames each
+*/
+bool  player::open(const char* path, int voices, int head_frames, int stream_frames) noexcept
+{
+      close();
+      if(voices <= 0) {
+          return false;
+      }
+      m_map_ptr = riff_map(path, m_map_size);
+      if(m_map_ptr == nullptr) {
+          return false;
+      }
+      if(riff_parse(m_map_ptr, m_map_size, m_info) == false) {
+          printdbg("Unrecognized or unsupported sample file `%s`.\n", __FILE__, __LINE__, path);
+          close();
+          return false;
+      }
+      if(m_info.channels > streamer_block_frames) {
+          // the streamer decodes through a block of `streamer_block_frames` samples, which must hold at least one frame
+          printdbg("Too many channels in sample file `%s`.\n", __FILE__, __LINE__, path);
+          close();
+          return false;
+      }
+      if(static_cast<std::uint64_t>(head_frames) > m_info.frame_count) {
+          head_frames = m_info.frame_count;
+      }
+      if(head_frames > 0) {
+          m_head_ptr = reinterpret_cast<fptype*>(malloc(head_frames * m_info.channels * sizeof(fptype)));
+          if(m_head_ptr == nullptr) {
+              close();
+              return false;
+          }
+          riff_decode(m_head_ptr, m_info.channels, m_map_ptr + m_info.data_offset, m_info.channels, m_info.encoding, head_frames);
+      }
+      m_head_frames = head_frames;
+      m_mix_ptr = reinterpret_cast<fptype*>(malloc(streamer_block_frames * m_info.channels * sizeof(fptype)));
+      m_voice_ptr = reinterpret_cast<voice_t*>(malloc(voices * sizeof(voice_t)));
+      if((m_mix_ptr == nullptr) || (m_voice_ptr == nullptr)) {
+          close();
+          return false;
+      }
+      for(int i_voice = 0; i_voice < voices; i_voice++) {
+          voice_t* p_voice = new(m_voice_ptr + i_voice) voice_t;
+          p_voice->play_index = 0u;
+          p_voice->play_command = 0u;
+          p_voice->sync_bit = false;
+          p_voice->fetch_index = 0u;
+          p_voice->fetch_command = 0u;
+          p_voice->command.store(0u);
+          p_voice->ack_command.store(0u);
+          p_voice->ack_mark.store(0u);
+          m_voice_count++;
+          if(p_voice->stream.reset(stream_frames * m_info.channels) == false) {
+              close();
+              return false;
+          }
+      }
+      m_underrun_count.store(0u);
+      return true;
+}
+
+/* close()
+   release the sample file and the voices; the player is detached from its streamer first
+*/
+void  player::close() noexcept
+{
+      if(m_streamer != nullptr) {
+          m_streamer->detach(this);
+      }
+      if(m_voice_ptr != nullptr) {
+          for(int i_voice = 0; i_voice < m_voice_count; i_voice++) {
+              m_voice_ptr[i_voice].~voice_t();
+          }
+          free(m_voice_ptr);
+          m_voice_ptr = nullptr;
+          m_voice_count = 0;
+      }
+      if(m_mix_ptr != nullptr) {
+          free(m_mix_ptr);
+          m_mix_ptr = nullptr;
+      }
+      if(m_head_ptr != nullptr) {
+          free(m_head_ptr);
+          m_head_ptr = nullptr;
+          m_head_frames = 0;
+      }
+      if(m_map_ptr != nullptr) {
+          riff_unmap(m_map_ptr, m_map_size);
+          m_map_ptr = nullptr;
+          m_map_size = 0u;
+      }
+      m_info = riff_info_t();
+}
+
+/* play()
+   (re)start the given voice from the beginning of the sample; control thread only
+*/
+bool  player::play(int voice) noexcept
+{
+      if((voice >= 0) && (voice < m_voice_count)) {
+          voice_t&     l_voice = m_voice_ptr[voice];
+          unsigned int l_command = l_voice.command.load(std::memory_order_relaxed);
+          l_voice.command.store((((l_command >> 1) + 1u) << 1) | cmd_play, std::memory_order_release);
+          if(m_streamer != nullptr) {
+              m_streamer->wake();
+          }
+          return true;
+      }
+      return false;
+}
+
+/* stop()
+   silence the given voice; control thread only
+*/
+bool  player::stop(int voice) noexcept
+{
+      if((voice >= 0) && (voice < m_voice_count)) {
+          voice_t&     l_voice = m_voice_ptr[voice];
+          unsigned int l_command = l_voice.command.load(std::memory_order_relaxed);
+          l_voice.command.store(((l_command >> 1) + 1u) << 1, std::memory_order_release);
+          if(m_streamer != nullptr) {
+              m_streamer->wake();
+          }
+          return true;
+      }
+      return false;
+}
+
+bool  player::is_playing(int voice) const noexcept
+{
+      if((voice >= 0) && (voice < m_voice_count)) {
+          return m_voice_ptr[voice].command.load(std::memory_order_relaxed) & cmd_play;
+      }
+      return false;
+}
+
+std::uint64_t player::get_frame_count() const noexcept
+{
+      return m_info.frame_count;
+}
+
+int   player::get_channel_count() const noexcept
+{
+      return m_info.channels;
+}
+
+int   player::get_sample_rate() const noexcept
+{
+      return m_info.sample_rate;
+}
+
+int   player::get_voice_count() const noexcept
+{
+      return m_voice_count;
+}
+
+unsigned int player::get_underrun_count() const noexcept
+{
+      return m_underrun_count.load(std::memory_order_relaxed);
+}
+
+streamer* player::get_streamer() const noexcept
+{
+      return m_streamer;
+}
+
+bool  player::is_open() const noexcept
+{
+      return m_map_ptr != nullptr;
+}
+
+/*namespace dsp*/ }
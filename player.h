@@ -0,0 +1,111 @@
+#ifndef dsp_player_h
+#define dsp_player_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include "ring.h"
+#include "riff.h"
+#include <atomic>
+#include <cstdint>
+
+namespace dsp {
+
+class streamer;
+
+/* player
+   disk streaming sample player: the first frames of the sample are decoded into resident memory when the file is opened,
+   so that a voice can start sounding immediately, while the rest is fed to each voice through its own ring by a
+   `streamer` thread; the render thread never blocks on the file - if a ring runs dry the rest of the vector is left silent
+   and the event is accounted for as an underrun
+*/
+class player: public core
+{
+  public:
+  static constexpr unsigned int cmd_play = 1u;
+
+  /* voice_t
+     voice state; `command` is written by the control thread and carries a serial number in the upper bits, such that
+     every trigger is seen as a new command; the render thread only ever clears the play bit of the command it is playing,
+     once the sample is over; the streamer acknowledges a command by publishing the ring write mark it took when it reset
+     its fetch position, everything before the mark belongs to a previous command
+  */
+  struct voice_t
+  {
+    ring            stream;
+    std::uint64_t   play_index;     // render thread
+    unsigned int    play_command;   // render thread: last command seen
+    bool            sync_bit;       // render thread: frames of previous commands were dropped from the stream
+    std::uint64_t   fetch_index;    // streamer thread
+    unsigned int    fetch_command;  // streamer thread: last command seen
+    alignas(memory_line_size)
+    std::atomic<unsigned int> command;
+    std::atomic<unsigned int> ack_command;
+    std::atomic<unsigned int> ack_mark;
+  };
+
+  private:
+  const std::uint8_t* m_map_ptr;
+  std::uint64_t m_map_size;
+  riff_info_t   m_info;
+  fptype*       m_head_ptr;
+  int           m_head_frames;
+  fptype*       m_mix_ptr;
+  voice_t*      m_voice_ptr;
+  int           m_voice_count;
+  streamer*     m_streamer;
+  player*       m_player_next;
+  std::atomic<unsigned int>  m_underrun_count;
+
+  protected:
+          bool    dsp_fetch(fptype*, int) noexcept;
+          void    dsp_mix(fptype*, int, int, fptype*, int) noexcept;
+  virtual bool    render(unsigned int) noexcept override;
+
+  friend class streamer;
+  public:
+          player() noexcept;
+          player(const player&) noexcept = delete;
+          player(player&&) noexcept = delete;
+  virtual ~player();
+
+          bool    open(const char*, int, int = player_head_frames, int = player_stream_frames) noexcept;
+          void    close() noexcept;
+
+          bool    play(int) noexcept;
+          bool    stop(int) noexcept;
+          bool    is_playing(int) const noexcept;
+
+          std::uint64_t get_frame_count() const noexcept;
+          int     get_channel_count() const noexcept;
+          int     get_sample_rate() const noexcept;
+          int     get_voice_count() const noexcept;
+          unsigned int get_underrun_count() const noexcept;
+          streamer* get_streamer() const noexcept;
+          bool    is_open() const noexcept;
+
+          player& operator=(const player&) noexcept = delete;
+          player& operator=(player&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
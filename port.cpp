@@ -0,0 +1,103 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "port.h"
+
+namespace dsp {
+
+      port::port() noexcept:
+      port(o_none)
+{
+}
+
+      port::port(unsigned int option) noexcept:
+      core(option | o_port),
+      m_data_ptr(nullptr),
+      m_data_frames(0),
+      m_feed_ptr(nullptr)
+{
+}
+
+      port::~port()
+{
+}
+
+/* feed()
+   supply the memory for `frames` frames of the current render pass; called once per pass, regardless of how many gates
+   the port is attached to
+*/
+fptype* port::feed(int frames) noexcept
+{
+      fptype* l_data_ptr = m_data_ptr;
+      if(l_data_ptr != nullptr) {
+          m_data_ptr = nullptr;
+          if(frames <= m_data_frames) {
+              return l_data_ptr;
+          }
+          printdbg(
+              "Input buffer of %d frames is too small for a render of %d frames.\n",
+              __FILE__,
+              __LINE__,
+              m_data_frames,
+              frames
+          );
+      }
+      return nullptr;
+}
+
+/* bind()
+   bind the caller supplied memory for the next render pass; the memory is expected to be laid out in the sample format of
+   the consuming branches
+*/
+bool  port::bind(fptype* data, int frames) noexcept
+{
+      if(data != nullptr) {
+          if(frames > 0) {
+              m_data_ptr = data;
+              m_data_frames = frames;
+              return true;
+          }
+      }
+      return false;
+}
+
+void  port::unbind() noexcept
+{
+      m_data_ptr = nullptr;
+      m_data_frames = 0;
+}
+
+fptype* port::get_data() const noexcept
+{
+      return m_data_ptr;
+}
+
+int   port::get_frames() const noexcept
+{
+      return m_data_frames;
+}
+
+bool  port::is_bound() const noexcept
+{
+      return m_data_ptr != nullptr;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,63 @@
+#ifndef dsp_port_h
+#define dsp_port_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+
+namespace dsp {
+
+/* port
+   external input node: hands caller owned sample memory (audio input, file readers) to the gates it is attached to, without
+   copying it into the sample store; a bound buffer is consumed by the first render pass that reaches the port, so it needs
+   to be bound again before each render
+*/
+class port: public core
+{
+  fptype*   m_data_ptr;
+  int       m_data_frames;
+  fptype*   m_feed_ptr;           // memory handed to the gates during the current render pass
+
+  protected:
+  virtual fptype* feed(int) noexcept;
+
+  friend class  apu;
+  public:
+          port() noexcept;
+          port(unsigned int) noexcept;
+          port(const port&) noexcept = delete;
+          port(port&&) noexcept = delete;
+  virtual ~port();
+
+          bool    bind(fptype*, int) noexcept;
+          void    unbind() noexcept;
+
+          fptype* get_data() const noexcept;
+          int     get_frames() const noexcept;
+          bool    is_bound() const noexcept;
+
+          port& operator=(const port&) noexcept = delete;
+          port& operator=(port&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
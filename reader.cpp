@@ -0,0 +1,246 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "reader.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace dsp {
+
+      reader::reader() noexcept:
+      port(),
+      m_map_ptr(nullptr),
+      m_map_size(0u),
+      m_prefetch_offset(0u),
+      m_info(),
+      m_frame_index(0u),
+      m_convert_ptr(nullptr),
+      m_convert_size(0),
+      m_loop(false)
+{
+}
+
+      reader::~reader()
+{
+      close();
+      if(m_convert_ptr != nullptr) {
+          free(m_convert_ptr);
+      }
+}
+
+/* dsp_prefetch()
+   ask the kernel to page in the file range ahead of the given offset; the range is only advised once the play position
+   gets within half a prefetch window of the end of the previously advised range
+*/
+void  reader::dsp_prefetch(std::uint64_t offset) noexcept
+{
+      std::uint64_t l_page_size = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+      if(offset + reader_prefetch_size / 2 >= m_prefetch_offset) {
+          std::uint64_t l_base = offset & ~(l_page_size - 1u);
+          std::uint64_t l_size = reader_prefetch_size;
+          if(l_base < m_map_size) {
+              if(l_base + l_size > m_map_size) {
+                  l_size = m_map_size - l_base;
+              }
+              madvise(const_cast<std::uint8_t*>(m_map_ptr) + l_base, l_size, MADV_WILLNEED);
+              m_prefetch_offset = l_base + l_size;
+          }
+      }
+}
+
+/* dsp_reserve()
+   make sure the conversion buffer holds at least `size` samples
+*/
+bool  reader::dsp_reserve(int size) noexcept
+{
+      if(size > m_convert_size) {
+          int   l_size = get_round_value(size, memory_vector_block);
+          void* l_convert_ptr = std::aligned_alloc(memory_vector_block * sizeof(fptype), l_size * sizeof(fptype));
+          if(l_convert_ptr == nullptr) {
+              return false;
+          }
+          if(m_convert_ptr != nullptr) {
+              free(m_convert_ptr);
+          }
+          m_convert_ptr = reinterpret_cast<fptype*>(l_convert_ptr);
+          m_convert_size = l_size;
+      }
+      return true;
+}
+
+/* feed()
+   hand out the next `frames` frames of the file; frames past the end of the file are either wrapped around (when looping)
+   or silenced
+*/
+fptype* reader::feed(int frames) noexcept
+{
+      const std::uint8_t* l_data_ptr;
+      int   l_channels;
+      if(m_map_ptr == nullptr) {
+          return port::feed(frames);
+      }
+      l_data_ptr = m_map_ptr + m_info.data_offset;
+      l_channels = dsp_get_sample_size();
+      // same layout on disk as in the branch: hand out the mapped pages
+      if(riff_is_native(m_info.encoding)) {
+          if(m_info.channels == l_channels) {
+              if(m_frame_index + frames <= m_info.frame_count) {
+                  const std::uint8_t* l_block_ptr = l_data_ptr + m_frame_index * m_info.frame_size;
+                  if(reinterpret_cast<std::uintptr_t>(l_block_ptr) % alignof(fptype) == 0) {
+                      m_frame_index += frames;
+                      dsp_prefetch(m_info.data_offset + m_frame_index * m_info.frame_size);
+                      return reinterpret_cast<fptype*>(const_cast<std::uint8_t*>(l_block_ptr));
+                  }
+              }
+          }
+      }
+      // different layout, misaligned data or the block crosses the end of the file: decode
+      if(dsp_reserve(frames * l_channels)) {
+          fptype* p_convert = m_convert_ptr;
+          int     l_frames = frames;
+          while(l_frames > 0) {
+              std::uint64_t l_frames_left = m_info.frame_count - m_frame_index;
+              if(l_frames_left == 0) {
+                  if(m_loop) {
+                      if(m_info.frame_count > 0) {
+                          m_frame_index = 0;
+                          continue;
+                      }
+                  }
+                  pcm_clr(p_convert, l_frames * l_channels);
+                  break;
+              }
+              int  l_copy_frames = static_cast<std::uint64_t>(l_frames) < l_frames_left ? l_frames : static_cast<int>(l_frames_left);
+              riff_decode(
+                  p_convert,
+                  l_channels,
+                  l_data_ptr + m_frame_index * m_info.frame_size,
+                  m_info.channels,
+                  m_info.encoding,
+                  l_copy_frames
+              );
+              p_convert += l_copy_frames * l_channels;
+              m_frame_index += l_copy_frames;
+              l_frames -= l_copy_frames;
+          }
+          dsp_prefetch(m_info.data_offset + m_frame_index * m_info.frame_size);
+          return m_convert_ptr;
+      }
+      return nullptr;
+}
+
+/* open()
+   map a RIFF/WAVE or RF64 file
+*/
+bool  reader::open(const char* path) noexcept
+{
+      return open(path, 0, 0);
+}
+
+/* open()
+   map a sample file; if `channels` is non-zero the file is taken to be raw, headerless `fptype` data with the given
+   channel count and sample rate, otherwise it is parsed as a RIFF/WAVE or RF64 file
+*/
+bool  reader::open(const char* path, int channels, int sample_rate) noexcept
+{
+      close();
+      m_map_ptr = riff_map(path, m_map_size);
+      if(m_map_ptr == nullptr) {
+          return false;
+      }
+      if(channels > 0) {
+          m_info.encoding = sizeof(fptype) == sizeof(double) ? enc_f64 : enc_f32;
+          m_info.channels = channels;
+          m_info.sample_rate = sample_rate;
+          m_info.frame_size = channels * sizeof(fptype);
+          m_info.data_offset = 0u;
+          m_info.data_size = m_map_size;
+          m_info.frame_count = m_map_size / m_info.frame_size;
+      } else
+      if(riff_parse(m_map_ptr, m_map_size, m_info) == false) {
+          printdbg("Unrecognized or unsupported sample file `%s`.\n", __FILE__, __LINE__, path);
+          close();
+          return false;
+      }
+      m_frame_index = 0u;
+      m_prefetch_offset = 0u;
+      dsp_prefetch(m_info.data_offset);
+      return true;
+}
+
+void  reader::close() noexcept
+{
+      if(m_map_ptr != nullptr) {
+          riff_unmap(m_map_ptr, m_map_size);
+          m_map_ptr = nullptr;
+          m_map_size = 0u;
+      }
+      m_info = riff_info_t();
+      m_frame_index = 0u;
+}
+
+/* seek()
+   move the play position; not synchronized with the render thread, so it is expected to be called between renders
+*/
+bool  reader::seek(std::uint64_t frame) noexcept
+{
+      if(frame <= m_info.frame_count) {
+          m_frame_index = frame;
+          m_prefetch_offset = 0u;
+          if(m_map_ptr != nullptr) {
+              dsp_prefetch(m_info.data_offset + m_frame_index * m_info.frame_size);
+          }
+          return true;
+      }
+      return false;
+}
+
+std::uint64_t reader::get_position() const noexcept
+{
+      return m_frame_index;
+}
+
+std::uint64_t reader::get_frame_count() const noexcept
+{
+      return m_info.frame_count;
+}
+
+int   reader::get_channel_count() const noexcept
+{
+      return m_info.channels;
+}
+
+int   reader::get_sample_rate() const noexcept
+{
+      return m_info.sample_rate;
+}
+
+void  reader::set_loop(bool value) noexcept
+{
+      m_loop = value;
+}
+
+bool  reader::is_open() const noexcept
+{
+      return m_map_ptr != nullptr;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,75 @@
+#ifndef dsp_reader_h
+#define dsp_reader_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "port.h"
+#include "riff.h"
+#include <cstdint>
+
+namespace dsp {
+
+/* reader
+   sample file input node: maps a RIFF/WAVE, RF64 or raw float file into memory and hands it out to the attached gates one
+   render pass at a time; where the file is stored in the same layout as the consuming branch the mapped pages are handed
+   out directly, otherwise each block is decoded into a conversion buffer
+*/
+class reader: public port
+{
+  const std::uint8_t* m_map_ptr;
+  std::uint64_t   m_map_size;
+  std::uint64_t   m_prefetch_offset;  // end of the range last advised to the kernel
+  riff_info_t     m_info;
+  std::uint64_t   m_frame_index;
+  fptype*         m_convert_ptr;
+  int             m_convert_size;
+  bool            m_loop;
+
+  protected:
+          void    dsp_prefetch(std::uint64_t) noexcept;
+          bool    dsp_reserve(int) noexcept;
+  virtual fptype* feed(int) noexcept override;
+
+  public:
+          reader() noexcept;
+          reader(const reader&) noexcept = delete;
+          reader(reader&&) noexcept = delete;
+  virtual ~reader();
+
+          bool    open(const char*) noexcept;
+          bool    open(const char*, int, int) noexcept;
+          void    close() noexcept;
+
+          bool    seek(std::uint64_t) noexcept;
+          std::uint64_t get_position() const noexcept;
+          std::uint64_t get_frame_count() const noexcept;
+          int     get_channel_count() const noexcept;
+          int     get_sample_rate() const noexcept;
+          void    set_loop(bool) noexcept;
+          bool    is_open() const noexcept;
+
+          reader& operator=(const reader&) noexcept = delete;
+          reader& operator=(reader&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
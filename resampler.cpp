@@ -0,0 +1,320 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "resampler.h"
+#include "config.h"
+#include "table.h"
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace dsp {
+
+/* resampler_key_t
+   design parameters of a resampler kernel, as the key of its table
+*/
+struct resampler_key_t
+{
+  int       taps;
+  int       phases;
+  double    cutoff;
+};
+
+/* resampler_build_kernel()
+   table store generator for the kernels: a blackman windowed sinc, tabulated at `phases + 1` fractional positions and
+   normalized to unity gain at DC for each
+*/
+static bool  resampler_build_kernel(void* data, std::size_t, const void* key, void*) noexcept
+{
+      auto    p_key = reinterpret_cast<const resampler_key_t*>(key);
+      auto    p_kernel = reinterpret_cast<fptype*>(data);
+      int     l_taps = p_key->taps;
+      double  l_cutoff = p_key->cutoff;
+      double  l_half = l_taps / 2;
+      for(int i_phase = 0; i_phase <= p_key->phases; i_phase++) {
+          fptype* p_row = p_kernel + i_phase * l_taps;
+          double  l_sum = 0.0;
+          for(int i_tap = 0; i_tap < l_taps; i_tap++) {
+              double l_t = i_tap - l_half + 1.0 - static_cast<double>(i_phase) / p_key->phases;
+              double l_x = l_cutoff * l_t;
+              double l_w = 0.0;
+              if(std::abs(l_t) < l_half) {
+                  double l_a = std::numbers::pi * l_t / l_half;
+                  l_w = 0.42 + 0.5 * std::cos(l_a) + 0.08 * std::cos(2.0 * l_a);
+              }
+              double l_h = l_cutoff * l_w;
+              if(l_x != 0.0) {
+                  l_h *= std::sin(std::numbers::pi * l_x) / (std::numbers::pi * l_x);
+              }
+              p_row[i_tap] = l_h;
+              l_sum += l_h;
+          }
+          for(int i_tap = 0; i_tap < l_taps; i_tap++) {
+              p_row[i_tap] /= l_sum;
+          }
+      }
+      return true;
+}
+
+      resampler::resampler() noexcept:
+      m_kernel(nullptr),
+      m_history(nullptr),
+      m_position(0.0),
+      m_taps(0),
+      m_channels(0),
+      m_capacity(0),
+      m_fill(0),
+      m_rate_in(0),
+      m_rate_out(0)
+{
+}
+
+      resampler::~resampler()
+{
+      dispose();
+}
+
+/* dsp_reserve()
+   make room in the history for another `frames` input frames
+*/
+bool  resampler::dsp_reserve(int frames) noexcept
+{
+      int l_capacity = m_fill + frames;
+      if(l_capacity > m_capacity) {
+          auto p_history = reinterpret_cast<fptype*>(malloc(l_capacity * m_channels * sizeof(fptype)));
+          if(p_history == nullptr) {
+              return false;
+          }
+          for(int i_channel = 0; i_channel < m_channels; i_channel++) {
+              std::memcpy(p_history + i_channel * l_capacity, m_history + i_channel * m_capacity, m_fill * sizeof(fptype));
+          }
+          free(m_history);
+          m_history = p_history;
+          m_capacity = l_capacity;
+      }
+      return true;
+}
+
+/* reset()
+   set up a converter from `rate_in` to `rate_out` for the given number of channels; the kernel is a blackman windowed sinc
+   with its cutoff just below the lower of the two nyquist frequencies
+*/
+bool  resampler::reset(int rate_in, int rate_out, int channels) noexcept
+{
+      if((rate_in > 0) &&
+          (rate_out > 0) &&
+          (channels > 0)) {
+          double  l_ratio = 1.0;
+          int     l_taps = resampler_taps;
+          if(rate_out < rate_in) {
+              // decimating: stretch the kernel along with the cutoff, within reason
+              l_ratio = static_cast<double>(rate_out) / static_cast<double>(rate_in);
+              l_taps = std::ceil(l_taps / l_ratio);
+              if(l_taps > resampler_taps * 32) {
+                  l_taps = resampler_taps * 32;
+              }
+              l_taps = get_round_value(l_taps, 4);
+          }
+          resampler_key_t l_key = {l_taps, resampler_phases, l_ratio * 0.9};
+          auto p_kernel = reinterpret_cast<const fptype*>(
+              tbl_acquire(tbl_kernel, l_key, (resampler_phases + 1) * l_taps * sizeof(fptype), resampler_build_kernel)
+          );
+          if(p_kernel == nullptr) {
+              return false;
+          }
+          dispose();
+          m_kernel = p_kernel;
+          m_taps = l_taps;
+          m_channels = channels;
+          m_rate_in = rate_in;
+          m_rate_out = rate_out;
+          // prime the history with a kernel worth of silence, such that the first output frame has its full support, and
+          // leave room for a run of input frames on top of it
+          if(dsp_reserve(l_taps + resampler_block_frames) == false) {
+              dispose();
+              return false;
+          }
+          std::memset(m_history, 0, m_capacity * m_channels * sizeof(fptype));
+          m_fill = l_taps;
+          m_position = l_taps / 2 - 1;
+          return true;
+      }
+      return false;
+}
+
+void  resampler::dispose() noexcept
+{
+      if(m_kernel != nullptr) {
+          free(m_history);
+          tbl_release(m_kernel);
+          m_kernel = nullptr;
+          m_history = nullptr;
+          m_taps = 0;
+          m_channels = 0;
+          m_capacity = 0;
+          m_fill = 0;
+          m_rate_in = 0;
+          m_rate_out = 0;
+      }
+}
+
+/* dsp_drop()
+   drop the leading `frames` frames of the history
+*/
+void  resampler::dsp_drop(int frames) noexcept
+{
+      for(int i_channel = 0; i_channel < m_channels; i_channel++) {
+          fptype* p_history = m_history + i_channel * m_capacity;
+          std::memmove(p_history, p_history + frames, (m_fill - frames) * sizeof(fptype));
+      }
+      m_fill -= frames;
+      m_position -= frames;
+}
+
+/* process()
+   consume `sp_frames` frames from `sp` and write (or add, if `additive`) exactly `dp_frames` frames onto `dp`; the strides
+   are the distance between the channel runs of a planar layout, 0 for interleaved frames; the input is taken into the
+   history in runs of up to `resampler_block_frames`, each followed by the output frames whose kernel it completes
+*/
+bool  resampler::process(fptype* dp, int dp_frames, int dp_stride, const fptype* sp, int sp_frames, int sp_stride, bool additive) noexcept
+{
+      if(m_kernel == nullptr) {
+          return false;
+      }
+      double l_step = 0.0;
+      double l_origin = m_position;
+      int    l_lead = m_taps / 2 - 1;
+      int    i_frame_in = 0;
+      int    i_frame_out = 0;
+      if(dp_frames > 0) {
+          l_step = static_cast<double>(sp_frames) / static_cast<double>(dp_frames);
+      }
+      while(true) {
+          // append the next run of the input to the history
+          int l_count = m_capacity - m_fill;
+          if(l_count > sp_frames - i_frame_in) {
+              l_count = sp_frames - i_frame_in;
+          }
+          for(int i_channel = 0; i_channel < m_channels; i_channel++) {
+              fptype*       p_history = m_history + i_channel * m_capacity + m_fill;
+              if(sp_stride > 0) {
+                  std::memcpy(p_history, sp + i_channel * sp_stride + i_frame_in, l_count * sizeof(fptype));
+              } else
+              if(true) {
+                  const fptype* p_source = sp + i_frame_in * m_channels + i_channel;
+                  for(int i_frame = 0; i_frame < l_count; i_frame++) {
+                      p_history[i_frame] = p_source[i_frame * m_channels];
+                  }
+              }
+          }
+          m_fill += l_count;
+          i_frame_in += l_count;
+
+          // produce the output frames that have their full support in the history
+          while(i_frame_out < dp_frames) {
+              double  l_position = l_origin + i_frame_out * l_step;
+              int     l_base = static_cast<int>(l_position);
+              if(l_base - l_lead + m_taps > m_fill) {
+                  break;
+              }
+              double  l_phase = (l_position - l_base) * resampler_phases;
+              int     l_row = static_cast<int>(l_phase);
+              fptype  l_blend = l_phase - l_row;
+              const fptype* p_k0 = m_kernel + l_row * m_taps;
+              const fptype* p_k1 = p_k0 + m_taps;
+              for(int i_channel = 0; i_channel < m_channels; i_channel++) {
+                  const fptype* p_x = m_history + i_channel * m_capacity + l_base - l_lead;
+                  fptype  l_s0 = 0.0f;
+                  fptype  l_s1 = 0.0f;
+                  for(int i_tap = 0; i_tap < m_taps; i_tap++) {
+                      l_s0 += p_k0[i_tap] * p_x[i_tap];
+                      l_s1 += p_k1[i_tap] * p_x[i_tap];
+                  }
+                  fptype  l_value = l_s0 + (l_s1 - l_s0) * l_blend;
+                  fptype* p_out;
+                  if(dp_stride > 0) {
+                      p_out = dp + i_channel * dp_stride + i_frame_out;
+                  } else
+                      p_out = dp + i_frame_out * m_channels + i_channel;
+                  if(additive) {
+                      *p_out += l_value;
+                  } else
+                      *p_out = l_value;
+              }
+              i_frame_out++;
+          }
+          if(i_frame_in == sp_frames) {
+              break;
+          }
+
+          // make room for the next run: drop the history that falls before the kernel of the next output frame (or of the
+          // end of the input, once the output is done), always keeping a kernel worth of it
+          double l_next = l_origin + sp_frames;
+          if(i_frame_out < dp_frames) {
+              l_next = l_origin + i_frame_out * l_step;
+          }
+          int l_drop = static_cast<int>(l_next) - l_lead;
+          if(l_drop > m_fill - m_taps) {
+              l_drop = m_fill - m_taps;
+          }
+          if(l_drop > 0) {
+              dsp_drop(l_drop);
+              l_origin -= l_drop;
+          }
+      }
+      m_position += sp_frames;
+
+      // drop the history that no longer falls under the kernel
+      if(int l_drop = static_cast<int>(m_position) - l_lead; l_drop > 0) {
+          dsp_drop(l_drop);
+      }
+      return true;
+}
+
+int   resampler::get_rate_in() const noexcept
+{
+      return m_rate_in;
+}
+
+int   resampler::get_rate_out() const noexcept
+{
+      return m_rate_out;
+}
+
+int   resampler::get_channel_count() const noexcept
+{
+      return m_channels;
+}
+
+/* get_latency()
+   delay of the converter, in input frames
+*/
+int   resampler::get_latency() const noexcept
+{
+      return m_taps / 2;
+}
+
+bool  resampler::is_valid() const noexcept
+{
+      return m_kernel != nullptr;
+}
+
+/*namespace dsp*/ }
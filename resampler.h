@@ -0,0 +1,72 @@
+#ifndef dsp_resampler_h
+#define dsp_resampler_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+
+namespace dsp {
+
+/* resampler
+   streaming polyphase sample rate converter: a windowed sinc kernel tabulated at `resampler_phases` fractional positions,
+   interpolated linearly in between; each call consumes all of the given input frames and produces exactly the requested
+   number of output frames, the ratio between the two being taken from the call itself, such that the rounding of the
+   frame counts of either side never accumulates into a drift; the nominal rates only shape the kernel
+*/
+class resampler
+{
+  const fptype* m_kernel;         // (phases + 1) rows of `taps` coefficients
+  fptype*   m_history;            // input history, one run of `capacity` samples per channel
+  double    m_position;           // input position of the next output frame, relative to the start of the history
+  int       m_taps;
+  int       m_channels;
+  int       m_capacity;
+  int       m_fill;
+  int       m_rate_in;
+  int       m_rate_out;
+
+  protected:
+          bool    dsp_reserve(int) noexcept;
+          void    dsp_drop(int) noexcept;
+
+  public:
+          resampler() noexcept;
+          resampler(const resampler&) noexcept = delete;
+          resampler(resampler&&) noexcept = delete;
+          ~resampler();
+
+          bool    reset(int, int, int) noexcept;
+          void    dispose() noexcept;
+
+          bool    process(fptype*, int, int, const fptype*, int, int, bool = false) noexcept;
+
+          int     get_rate_in() const noexcept;
+          int     get_rate_out() const noexcept;
+          int     get_channel_count() const noexcept;
+          int     get_latency() const noexcept;
+          bool    is_valid() const noexcept;
+
+          resampler& operator=(const resampler&) noexcept = delete;
+          resampler& operator=(resampler&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
@@ -0,0 +1,366 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "riff.h"
+#include <cstring>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dsp {
+
+/* riff_map()
+   map a whole file into memory, read only and advised for sequential access; the image is only ever handed out as const,
+   and a stray write through it faults rather than being dropped onto a private copy of the page
+*/
+const std::uint8_t* riff_map(const char* path, std::uint64_t& size) noexcept
+{
+      int         l_fd;
+      struct stat l_stat;
+      void*       l_map_ptr;
+      l_fd = open(path, O_RDONLY);
+      if(l_fd < 0) {
+          printdbg("Failed to open sample file `%s`.\n", __FILE__, __LINE__, path);
+          return nullptr;
+      }
+      if(fstat(l_fd, std::addressof(l_stat)) != 0) {
+          close(l_fd);
+          return nullptr;
+      }
+      if(l_stat.st_size <= 0) {
+          close(l_fd);
+          return nullptr;
+      }
+      l_map_ptr = mmap(nullptr, l_stat.st_size, PROT_READ, MAP_PRIVATE, l_fd, 0);
+      close(l_fd);
+      if(l_map_ptr == MAP_FAILED) {
+          printdbg("Failed to map sample file `%s`.\n", __FILE__, __LINE__, path);
+          return nullptr;
+      }
+      madvise(l_map_ptr, l_stat.st_size, MADV_SEQUENTIAL);
+      size = l_stat.st_size;
+      return reinterpret_cast<const std::uint8_t*>(l_map_ptr);
+}
+
+void  riff_unmap(const std::uint8_t* data, std::uint64_t size) noexcept
+{
+      munmap(const_cast<std::uint8_t*>(data), size);
+}
+
+/* riff_parse()
+   walk the chunks of a RIFF/WAVE or RF64 file image and locate the sample data
+*/
+bool  riff_parse(const std::uint8_t* data, std::uint64_t size, riff_info_t& info) noexcept
+{
+      riff_head_t   l_head;
+      riff_fmt_t    l_fmt;
+      std::uint64_t l_ds64_data_size = 0u;
+      bool          l_rf64 = false;
+      bool          l_fmt_found = false;
+      unsigned int  l_format_tag;
+
+      if(size < sizeof(riff_head_t)) {
+          return false;
+      }
+      std::memcpy(std::addressof(l_head), data, sizeof(l_head));
+      if(std::memcmp(l_head.type, "WAVE", 4) != 0) {
+          return false;
+      }
+      if(std::memcmp(l_head.id, "RF64", 4) == 0) {
+          l_rf64 = true;
+      } else
+      if(std::memcmp(l_head.id, "RIFF", 4) != 0) {
+          return false;
+      }
+
+      std::uint64_t i_offset = sizeof(riff_head_t);
+      while(i_offset + sizeof(riff_chunk_t) <= size) {
+          riff_chunk_t  l_chunk;
+          std::uint64_t l_chunk_size;
+          std::memcpy(std::addressof(l_chunk), data + i_offset, sizeof(l_chunk));
+          i_offset += sizeof(riff_chunk_t);
+          l_chunk_size = l_chunk.size;
+          if(std::memcmp(l_chunk.id, "ds64", 4) == 0) {
+              if(l_chunk_size >= riff_ds64_size) {
+                  riff_ds64_t l_ds64;
+                  if(i_offset + riff_ds64_size > size) {
+                      return false;
+                  }
+                  std::memcpy(std::addressof(l_ds64), data + i_offset, riff_ds64_size);
+                  l_ds64_data_size = l_ds64.data_size;
+              }
+          } else
+          if(std::memcmp(l_chunk.id, "fmt ", 4) == 0) {
+              if(l_chunk_size >= sizeof(riff_fmt_t)) {
+                  if(i_offset + sizeof(riff_fmt_t) > size) {
+                      return false;
+                  }
+                  std::memcpy(std::addressof(l_fmt), data + i_offset, sizeof(l_fmt));
+                  l_format_tag = l_fmt.format_tag;
+                  if(l_format_tag == wave_format_extensible) {
+                      // the actual format tag leads the sub-format GUID, 24 bytes into the extension
+                      std::uint16_t l_sub_format;
+                      if(l_chunk_size >= sizeof(riff_fmt_t) + 10) {
+                          if(i_offset + sizeof(riff_fmt_t) + 10 > size) {
+                              return false;
+                          }
+                          std::memcpy(std::addressof(l_sub_format), data + i_offset + sizeof(riff_fmt_t) + 8, sizeof(l_sub_format));
+                          l_format_tag = l_sub_format;
+                      }
+                  }
+                  l_fmt_found = true;
+              }
+          } else
+          if(std::memcmp(l_chunk.id, "data", 4) == 0) {
+              if(l_fmt_found == false) {
+                  return false;
+              }
+              if(l_rf64 && (l_chunk.size == riff_size_max)) {
+                  l_chunk_size = l_ds64_data_size;
+              }
+              if(l_chunk_size > size - i_offset) {
+                  l_chunk_size = size - i_offset;
+              }
+              info.encoding = enc_none;
+              if(l_format_tag == wave_format_pcm) {
+                  switch(l_fmt.bits_per_sample) {
+                      case 8:
+                          info.encoding = enc_u8;
+                          break;
+                      case 16:
+                          info.encoding = enc_s16;
+                          break;
+                      case 24:
+                          info.encoding = enc_s24;
+                          break;
+                      case 32:
+                          info.encoding = enc_s32;
+                          break;
+                  };
+              } else
+              if(l_format_tag == wave_format_float) {
+                  switch(l_fmt.bits_per_sample) {
+                      case 32:
+                          info.encoding = enc_f32;
+                          break;
+                      case 64:
+                          info.encoding = enc_f64;
+                          break;
+                  };
+              }
+              if(info.encoding == enc_none) {
+                  return false;
+              }
+              if(l_fmt.channels == 0) {
+                  return false;
+              }
+              info.channels = l_fmt.channels;
+              info.sample_rate = l_fmt.sample_rate;
+              info.frame_size = l_fmt.channels * riff_get_encoding_size(info.encoding);
+              info.data_offset = i_offset;
+              info.data_size = l_chunk_size;
+              info.frame_count = l_chunk_size / info.frame_size;
+              return true;
+          }
+          // chunks are padded to an even size
+          i_offset += l_chunk_size + (l_chunk_size & 1u);
+      }
+      return false;
+}
+
+/* riff_get_channel_mask()
+   speaker positions of the WAVE_FORMAT_EXTENSIBLE layout for the given number of channels: the common layouts for 1, 2, 4
+   (quad), 6 (5.1) and 8 (7.1) channels, the first positions in order otherwise
+*/
+std::uint32_t riff_get_channel_mask(int channels) noexcept
+{
+      switch(channels) {
+          case 1:
+              return 0x0004u;
+          case 2:
+              return 0x0003u;
+          case 4:
+              return 0x0033u;
+          case 6:
+              return 0x003fu;
+          case 8:
+              return 0x063fu;
+      };
+      if(channels < 32) {
+          return (1u << channels) - 1u;
+      }
+      return 0u;
+}
+
+/* riff_get_encoding_size()
+   size of a single sample in the given encoding, in bytes
+*/
+int   riff_get_encoding_size(unsigned int encoding) noexcept
+{
+      switch(encoding) {
+          case enc_u8:
+              return 1;
+          case enc_s16:
+              return 2;
+          case enc_s24:
+              return 3;
+          case enc_s32:
+              return 4;
+          case enc_f32:
+              return 4;
+          case enc_f64:
+              return 8;
+      };
+      return 0;
+}
+
+/* riff_is_native()
+   check if samples in the given encoding can be used in place, as `fptype`
+*/
+bool  riff_is_native(unsigned int encoding) noexcept
+{
+      if constexpr (sizeof(fptype) == sizeof(float)) {
+          return encoding == enc_f32;
+      } else
+      if constexpr (sizeof(fptype) == sizeof(double)) {
+          return encoding == enc_f64;
+      }
+      return false;
+}
+
+/* riff_decode_*()
+   convert `count` samples, spaced `step` samples apart, to fptype
+*/
+static void riff_decode_u8(fptype* dp, int dp_step, const std::uint8_t* sp, int sp_step, int count) noexcept
+{
+      for(int i_sample = 0; i_sample < count; i_sample++) {
+          dp[i_sample * dp_step] = static_cast<fptype>(static_cast<int>(sp[i_sample * sp_step]) - 128) * (1.0f / 128.0f);
+      }
+}
+
+static void riff_decode_s16(fptype* dp, int dp_step, const std::uint8_t* sp, int sp_step, int count) noexcept
+{
+      for(int i_sample = 0; i_sample < count; i_sample++) {
+          std::int16_t l_value;
+          std::memcpy(std::addressof(l_value), sp + i_sample * sp_step * 2, sizeof(l_value));
+          dp[i_sample * dp_step] = static_cast<fptype>(l_value) * (1.0f / 32768.0f);
+      }
+}
+
+static void riff_decode_s24(fptype* dp, int dp_step, const std::uint8_t* sp, int sp_step, int count) noexcept
+{
+      for(int i_sample = 0; i_sample < count; i_sample++) {
+          const std::uint8_t* l_sp = sp + i_sample * sp_step * 3;
+          std::int32_t l_value = 
+              static_cast<std::int32_t>(
+                  (static_cast<std::uint32_t>(l_sp[0]) << 8) |
+                  (static_cast<std::uint32_t>(l_sp[1]) << 16) |
+                  (static_cast<std::uint32_t>(l_sp[2]) << 24)
+              );
+          dp[i_sample * dp_step] = static_cast<fptype>(l_value) * (1.0f / 2147483648.0f);
+      }
+}
+
+static void riff_decode_s32(fptype* dp, int dp_step, const std::uint8_t* sp, int sp_step, int count) noexcept
+{
+      for(int i_sample = 0; i_sample < count; i_sample++) {
+          std::int32_t l_value;
+          std::memcpy(std::addressof(l_value), sp + i_sample * sp_step * 4, sizeof(l_value));
+          dp[i_sample * dp_step] = static_cast<fptype>(l_value) * (1.0f / 2147483648.0f);
+      }
+}
+
+static void riff_decode_f32(fptype* dp, int dp_step, const std::uint8_t* sp, int sp_step, int count) noexcept
+{
+      for(int i_sample = 0; i_sample < count; i_sample++) {
+          float l_value;
+          std::memcpy(std::addressof(l_value), sp + i_sample * sp_step * 4, sizeof(l_value));
+          dp[i_sample * dp_step] = l_value;
+      }
+}
+
+static void riff_decode_f64(fptype* dp, int dp_step, const std::uint8_t* sp, int sp_step, int count) noexcept
+{
+      for(int i_sample = 0; i_sample < count; i_sample++) {
+          double l_value;
+          std::memcpy(std::addressof(l_value), sp + i_sample * sp_step * 8, sizeof(l_value));
+          dp[i_sample * dp_step] = l_value;
+      }
+}
+
+/* riff_decode()
+   convert `frames` frames of `sp_channels` interleaved samples in the given encoding onto `dp_channels` interleaved fptype
+   samples; when the channel counts match the whole block is converted in a single flat pass, otherwise the common
+   channels are converted one by one and the extra destination channels are silenced
+*/
+void  riff_decode(fptype* dp, int dp_channels, const std::uint8_t* sp, int sp_channels, unsigned int encoding, int frames) noexcept
+{
+      int l_pass_count;
+      int l_pass_size;
+      int l_dp_step;
+      int l_sp_step;
+      int l_sample_size = riff_get_encoding_size(encoding);
+      if(dp_channels == sp_channels) {
+          l_pass_count = 1;
+          l_pass_size = frames * dp_channels;
+          l_dp_step = 1;
+          l_sp_step = 1;
+      } else
+      if(true) {
+          l_pass_count = dp_channels < sp_channels ? dp_channels : sp_channels;
+          l_pass_size = frames;
+          l_dp_step = dp_channels;
+          l_sp_step = sp_channels;
+          for(int i_channel = l_pass_count; i_channel < dp_channels; i_channel++) {
+              for(int i_frame = 0; i_frame < frames; i_frame++) {
+                  dp[i_frame * dp_channels + i_channel] = 0.0f;
+              }
+          }
+      }
+      for(int i_pass = 0; i_pass < l_pass_count; i_pass++) {
+          fptype*             l_dp = dp + i_pass;
+          const std::uint8_t* l_sp = sp + i_pass * l_sample_size;
+          switch(encoding) {
+              case enc_u8:
+                  riff_decode_u8(l_dp, l_dp_step, l_sp, l_sp_step, l_pass_size);
+                  break;
+              case enc_s16:
+                  riff_decode_s16(l_dp, l_dp_step, l_sp, l_sp_step, l_pass_size);
+                  break;
+              case enc_s24:
+                  riff_decode_s24(l_dp, l_dp_step, l_sp, l_sp_step, l_pass_size);
+                  break;
+              case enc_s32:
+                  riff_decode_s32(l_dp, l_dp_step, l_sp, l_sp_step, l_pass_size);
+                  break;
+              case enc_f32:
+                  riff_decode_f32(l_dp, l_dp_step, l_sp, l_sp_step, l_pass_size);
+                  break;
+              case enc_f64:
+                  riff_decode_f64(l_dp, l_dp_step, l_sp, l_sp_step, l_pass_size);
+                  break;
+          };
+      }
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,125 @@
+#ifndef dsp_riff_h
+#define dsp_riff_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include <cstdint>
+
+namespace dsp {
+
+/* riff_*
+   RIFF/WAVE and RF64 file layout;
+   multi-byte fields are stored little-endian, which is assumed to match the host
+*/
+struct riff_chunk_t
+{
+  char            id[4];
+  std::uint32_t   size;
+};
+
+struct riff_head_t
+{
+  char            id[4];          // "RIFF" or "RF64"
+  std::uint32_t   size;           // 0xffffffff for RF64 files - the actual size is found in the `ds64` chunk
+  char            type[4];        // "WAVE"
+};
+
+struct riff_fmt_t
+{
+  std::uint16_t   format_tag;
+  std::uint16_t   channels;
+  std::uint32_t   sample_rate;
+  std::uint32_t   byte_rate;
+  std::uint16_t   block_align;
+  std::uint16_t   bits_per_sample;
+};
+
+/* riff_fmt_ext_t
+   extension that follows riff_fmt_t in the `fmt ` chunk of formats other than integer PCM; `size` counts the bytes after
+   it: 0 for a plain format tag, `riff_fmt_ext_size` for the WAVE_FORMAT_EXTENSIBLE layout, which carries the actual format
+   tag in the leading bytes of `sub_format`
+*/
+struct riff_fmt_ext_t
+{
+  std::uint16_t   size;
+  std::uint16_t   valid_bits_per_sample;
+  std::uint32_t   channel_mask;
+  std::uint8_t    sub_format[16];
+};
+
+struct riff_ds64_t
+{
+  std::uint64_t   riff_size;
+  std::uint64_t   data_size;
+  std::uint64_t   sample_count;
+  std::uint32_t   table_length;
+  std::uint32_t   reserved;       // pads the structure; not part of the on-disk chunk
+};
+
+static constexpr int           riff_ds64_size = 28;
+static constexpr int           riff_fmt_ext_size = 22;
+static constexpr std::uint32_t riff_size_max = 0xffffffffu;
+
+static constexpr unsigned int  wave_format_pcm = 0x0001;
+static constexpr unsigned int  wave_format_float = 0x0003;
+static constexpr unsigned int  wave_format_extensible = 0xfffe;
+
+/* enc_*
+   sample encodings found in RIFF/WAVE files
+*/
+static constexpr unsigned int  enc_none = 0u;
+static constexpr unsigned int  enc_u8  = 1u;
+static constexpr unsigned int  enc_s16 = 2u;
+static constexpr unsigned int  enc_s24 = 3u;
+static constexpr unsigned int  enc_s32 = 4u;
+static constexpr unsigned int  enc_f32 = 5u;
+static constexpr unsigned int  enc_f64 = 6u;
+
+/* riff_info_t
+   description of the sample data found in a RIFF/WAVE file
+*/
+struct riff_info_t
+{
+  std::uint64_t   data_offset;    // offset of the sample data from the beginning of the file
+  std::uint64_t   data_size;      // size of the sample data, in bytes
+  std::uint64_t   frame_count;
+  unsigned int    encoding;
+  int             channels;
+  int             sample_rate;
+  int             frame_size;     // size of a frame, in bytes
+};
+
+const std::uint8_t* riff_map(const char*, std::uint64_t&) noexcept;
+        void  riff_unmap(const std::uint8_t*, std::uint64_t) noexcept;
+        bool  riff_parse(const std::uint8_t*, std::uint64_t, riff_info_t&) noexcept;
+        int   riff_get_encoding_size(unsigned int) noexcept;
+std::uint32_t riff_get_channel_mask(int) noexcept;
+        bool  riff_is_native(unsigned int) noexcept;
+        void  riff_decode(fptype*, int, const std::uint8_t*, int, unsigned int, int) noexcept;
+
+static_assert(sizeof(riff_chunk_t) == 8, "unexpected padding in riff_chunk_t");
+static_assert(sizeof(riff_head_t) == 12, "unexpected padding in riff_head_t");
+static_assert(sizeof(riff_fmt_t) == 16, "unexpected padding in riff_fmt_t");
+static_assert(sizeof(riff_fmt_ext_t) == riff_fmt_ext_size + 2, "unexpected padding in riff_fmt_ext_t");
+
+/*namespace dsp*/ }
+#endif
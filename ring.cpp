@@ -0,0 +1,198 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "ring.h"
+#include <bit>
+
+namespace dsp {
+
+      ring::ring() noexcept:
+      m_data(nullptr),
+      m_mask(0u),
+      m_size(0),
+      m_head(0u),
+      m_tail(0u)
+{
+}
+
+      ring::ring(int capacity) noexcept:
+      ring()
+{
+      reset(capacity);
+}
+
+      ring::~ring()
+{
+      dispose();
+}
+
+/* reset()
+   (re)allocate the ring for at least `capacity` samples and drop its contents;
+   not safe to call while either the producer or the consumer are running
+*/
+bool  ring::reset(int capacity) noexcept
+{
+      if(capacity > 0) {
+          int   l_size  = std::bit_ceil(static_cast<unsigned int>(get_round_value(capacity, memory_vector_block)));
+          void* l_data  = std::aligned_alloc(memory_vector_block * sizeof(fptype), l_size * sizeof(fptype));
+          if(l_data != nullptr) {
+              dispose();
+              m_data = reinterpret_cast<fptype*>(l_data);
+              m_mask = l_size - 1;
+              m_size = l_size;
+              m_head.store(0u, std::memory_order_relaxed);
+              m_tail.store(0u, std::memory_order_relaxed);
+              return true;
+          }
+      }
+      return false;
+}
+
+void  ring::dispose() noexcept
+{
+      if(m_data != nullptr) {
+          free(m_data);
+          m_data = nullptr;
+          m_mask = 0u;
+          m_size = 0;
+      }
+}
+
+/* get_read_size()
+   number of samples available to the consumer
+*/
+int   ring::get_read_size() const noexcept
+{
+      return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+}
+
+/* get_write_size()
+   number of samples the producer can write without overrunning the consumer
+*/
+int   ring::get_write_size() const noexcept
+{
+      return m_size - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+}
+
+int   ring::get_capacity() const noexcept
+{
+      return m_size;
+}
+
+/* write()
+   producer side: copy up to `size` samples into the ring, return the number of samples written
+*/
+int   ring::write(const fptype* data, int size) noexcept
+{
+      unsigned int l_head = m_head.load(std::memory_order_relaxed);
+      unsigned int l_tail = m_tail.load(std::memory_order_acquire);
+      int          l_free = m_size - (l_head - l_tail);
+      int          l_copy_size = size < l_free ? size : l_free;
+      if(l_copy_size > 0) {
+          int l_base = l_head & m_mask;
+          int l_span = m_size - l_base;
+          if(l_copy_size <= l_span) {
+              std::memcpy(m_data + l_base, data, l_copy_size * sizeof(fptype));
+          } else
+          if(true) {
+              std::memcpy(m_data + l_base, data, l_span * sizeof(fptype));
+              std::memcpy(m_data, data + l_span, (l_copy_size - l_span) * sizeof(fptype));
+          }
+          m_head.store(l_head + l_copy_size, std::memory_order_release);
+          return l_copy_size;
+      }
+      return 0;
+}
+
+/* read()
+   consumer side: copy up to `size` samples out of the ring, return the number of samples read
+*/
+int   ring::read(fptype* data, int size) noexcept
+{
+      unsigned int l_tail = m_tail.load(std::memory_order_relaxed);
+      unsigned int l_head = m_head.load(std::memory_order_acquire);
+      int          l_used = l_head - l_tail;
+      int          l_copy_size = size < l_used ? size : l_used;
+      if(l_copy_size > 0) {
+          int l_base = l_tail & m_mask;
+          int l_span = m_size - l_base;
+          if(l_copy_size <= l_span) {
+              std::memcpy(data, m_data + l_base, l_copy_size * sizeof(fptype));
+          } else
+          if(true) {
+              std::memcpy(data, m_data + l_base, l_span * sizeof(fptype));
+              std::memcpy(data + l_span, m_data, (l_copy_size - l_span) * sizeof(fptype));
+          }
+          m_tail.store(l_tail + l_copy_size, std::memory_order_release);
+          return l_copy_size;
+      }
+      return 0;
+}
+
+/* skip()
+   consumer side: discard up to `size` samples, return the number of samples discarded
+*/
+int   ring::skip(int size) noexcept
+{
+      unsigned int l_tail = m_tail.load(std::memory_order_relaxed);
+      unsigned int l_head = m_head.load(std::memory_order_acquire);
+      int          l_used = l_head - l_tail;
+      int          l_skip_size = size < l_used ? size : l_used;
+      if(l_skip_size > 0) {
+          m_tail.store(l_tail + l_skip_size, std::memory_order_release);
+          return l_skip_size;
+      }
+      return 0;
+}
+
+/* clear()
+   consumer side: discard everything that is currently available
+*/
+void  ring::clear() noexcept
+{
+      m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+/* clear()
+   consumer side: discard everything that was written before the producer took the given write mark
+*/
+void  ring::clear(unsigned int mark) noexcept
+{
+      unsigned int l_tail = m_tail.load(std::memory_order_relaxed);
+      if(static_cast<int>(mark - l_tail) > 0) {
+          m_tail.store(mark, std::memory_order_release);
+      }
+}
+
+/* get_write_mark()
+   producer side: current value of the write counter
+*/
+unsigned int ring::get_write_mark() const noexcept
+{
+      return m_head.load(std::memory_order_relaxed);
+}
+
+bool  ring::is_valid() const noexcept
+{
+      return m_data != nullptr;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,75 @@
+#ifndef dsp_ring_h
+#define dsp_ring_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "config.h"
+#include <atomic>
+
+namespace dsp {
+
+/* ring
+   wait-free single producer/single consumer sample queue;
+   the capacity is a power of two number of `memory_vector_block` sized blocks and the storage is aligned to a block, such
+   that block sized transfers stay aligned; the read and write counters run freely and are only masked on access
+*/
+class ring
+{
+  fptype*       m_data;
+  unsigned int  m_mask;
+  int           m_size;
+
+  alignas(memory_line_size)
+  std::atomic<unsigned int>  m_head;    // write counter, owned by the producer
+  alignas(memory_line_size)
+  std::atomic<unsigned int>  m_tail;    // read counter, owned by the consumer
+
+  public:
+          ring() noexcept;
+          ring(int) noexcept;
+          ring(const ring&) noexcept = delete;
+          ring(ring&&) noexcept = delete;
+          ~ring();
+
+          bool    reset(int) noexcept;
+          void    dispose() noexcept;
+
+          int     get_read_size() const noexcept;
+          int     get_write_size() const noexcept;
+          int     get_capacity() const noexcept;
+
+          int     write(const fptype*, int) noexcept;
+          int     read(fptype*, int) noexcept;
+          int     skip(int) noexcept;
+          void    clear() noexcept;
+          void    clear(unsigned int) noexcept;
+
+          unsigned int get_write_mark() const noexcept;
+
+          bool    is_valid() const noexcept;
+
+          ring&   operator=(const ring&) noexcept = delete;
+          ring&   operator=(ring&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
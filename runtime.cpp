@@ -20,6 +20,246 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "runtime.h"
+#include <cstring>
+#include <type_traits>
 
 namespace dsp {
+
+using rt_bits_t = std::conditional_t<sizeof(fptype) == sizeof(std::uint64_t), std::uint64_t, std::uint32_t>;
+
+/* rt_map()
+   apply a lane function to every lane of the destination register
+*/
+template<typename Ft>
+static inline void rt_map(fptype* dst, Ft function) noexcept
+{
+      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+          dst[i_lane] = function(dst[i_lane]);
+      }
+}
+
+/* rt_zip()
+   apply a lane function to every lane pair of the destination and source registers
+*/
+template<typename Ft>
+static inline void rt_zip(fptype* dst, const fptype* src, Ft function) noexcept
+{
+      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+          dst[i_lane] = function(dst[i_lane], src[i_lane]);
+      }
+}
+
+template<typename Ft>
+static inline void rt_bitwise(fptype* dst, const fptype* src, Ft function) noexcept
+{
+      rt_zip(dst, src, [function](fptype lhs, fptype rhs) noexcept {
+          return std::bit_cast<fptype>(function(std::bit_cast<rt_bits_t>(lhs), std::bit_cast<rt_bits_t>(rhs)));
+      });
+}
+
+/* rt_approximate()
+   run one of the polynomial approximated operations at the given accuracy tier
+*/
+template<unsigned int Tier>
+static bool  rt_approximate(unsigned int op_code, fptype* dst, const fptype* src) noexcept
+{
+      switch(op_code) {
+          case micro::op_code_exp:
+              rt_map(dst, [](fptype x) noexcept { return rt_exp<Tier>(x); });
+              return true;
+          case micro::op_code_log:
+              rt_map(dst, [](fptype x) noexcept { return rt_log<Tier>(x); });
+              return true;
+          case micro::op_code_sin:
+              rt_map(dst, [](fptype x) noexcept { return rt_sin<Tier>(x); });
+              return true;
+          case micro::op_code_cos:
+              rt_map(dst, [](fptype x) noexcept { return rt_cos<Tier>(x); });
+              return true;
+          case micro::op_code_tanh:
+              rt_map(dst, [](fptype x) noexcept { return rt_tanh<Tier>(x); });
+              return true;
+          case micro::op_code_pow:
+              if(src != nullptr) {
+                  rt_zip(dst, src, [](fptype x, fptype y) noexcept { return rt_pow<Tier>(x, y); });
+                  return true;
+              }
+              return false;
+          default:
+              return false;
+      }
+}
+
+/* rt_exec()
+   execute a single instruction against the given register file and return the address of its destination register, or
+   nullptr on failure
+*/
+static fptype* rt_exec(const micro& inst, fptype* r_base) noexcept
+{
+      fptype*       l_dst = nullptr;
+      const fptype* l_src = nullptr;
+      bool          l_success = true;
+      if(inst.op_dst == micro::op_dst_r) {
+          l_dst = r_base + inst.dst.r;
+      } else
+          return nullptr;
+      if(inst.op_src == micro::op_src_r) {
+          l_src = r_base + inst.src.r;
+      } else
+      if(inst.op_src == micro::op_src_p) {
+          l_src = inst.src.p;
+      }
+      switch(inst.op_code) {
+          case micro::op_code_ret:
+              break;
+          case micro::op_code_imm:
+              if(l_success = l_src != nullptr; l_success) {
+                  fpu::reg_mov(l_dst, l_src[0]);
+              }
+              break;
+          case micro::op_code_mov:
+              if(l_success = l_src != nullptr; l_success) {
+                  std::memcpy(l_dst, l_src, fpu::pts * sizeof(fptype));
+              }
+              break;
+          case micro::op_code_pos:
+              break;
+          case micro::op_code_neg:
+              rt_map(l_dst, [](fptype x) noexcept { return -x; });
+              break;
+          case micro::op_code_abs:
+              rt_map(l_dst, [](fptype x) noexcept { return std::fabs(x); });
+              break;
+          case micro::op_code_sqrt:
+              rt_map(l_dst, [](fptype x) noexcept { return std::sqrt(x); });
+              break;
+          case micro::op_code_msk:
+              rt_map(l_dst, [](fptype x) noexcept { return x > 0 ? std::bit_cast<fptype>(~rt_bits_t(0)) : fptype(0); });
+              break;
+          case micro::op_code_add:
+          case micro::op_code_sub:
+          case micro::op_code_mul:
+          case micro::op_code_div:
+          case micro::op_code_min:
+          case micro::op_code_max:
+          case micro::op_code_and:
+          case micro::op_code_andn:
+          case micro::op_code_or:
+              if(l_success = l_src != nullptr; l_success) {
+                  switch(inst.op_code) {
+                      case micro::op_code_add:
+                          rt_zip(l_dst, l_src, [](fptype x, fptype y) noexcept { return x + y; });
+                          break;
+                      case micro::op_code_sub:
+                          rt_zip(l_dst, l_src, [](fptype x, fptype y) noexcept { return x - y; });
+                          break;
+                      case micro::op_code_mul:
+                          rt_zip(l_dst, l_src, [](fptype x, fptype y) noexcept { return x * y; });
+                          break;
+                      case micro::op_code_div:
+                          rt_zip(l_dst, l_src, [](fptype x, fptype y) noexcept { return x / y; });
+                          break;
+                      case micro::op_code_min:
+                          rt_zip(l_dst, l_src, [](fptype x, fptype y) noexcept { return y < x ? y : x; });
+                          break;
+                      case micro::op_code_max:
+                          rt_zip(l_dst, l_src, [](fptype x, fptype y) noexcept { return y > x ? y : x; });
+                          break;
+                      case micro::op_code_and:
+                          rt_bitwise(l_dst, l_src, [](rt_bits_t x, rt_bits_t y) noexcept { return x & y; });
+                          break;
+                      case micro::op_code_andn:
+                          rt_bitwise(l_dst, l_src, [](rt_bits_t x, rt_bits_t y) noexcept { return ~x & y; });
+                          break;
+                      case micro::op_code_or:
+                          rt_bitwise(l_dst, l_src, [](rt_bits_t x, rt_bits_t y) noexcept { return x | y; });
+                          break;
+                  }
+              }
+              break;
+          case micro::op_code_fma:
+          case micro::op_code_fms:
+          case micro::op_code_fnma:
+              if(l_success = inst.op_src == micro::op_src_rr; l_success) {
+                  const fptype* l_mul = r_base + inst.src.f.r;
+                  const fptype* l_acc = r_base + inst.src.f.a;
+                  if(inst.op_code == micro::op_code_fma) {
+                      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+                          l_dst[i_lane] = rt_fma(l_dst[i_lane], l_mul[i_lane], l_acc[i_lane]);
+                      }
+                  } else
+                  if(inst.op_code == micro::op_code_fms) {
+                      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+                          l_dst[i_lane] = rt_fma(l_dst[i_lane], l_mul[i_lane], -l_acc[i_lane]);
+                      }
+                  } else {
+                      for(int i_lane = 0; i_lane < fpu::pts; i_lane++) {
+                          l_dst[i_lane] = rt_fma(-l_dst[i_lane], l_mul[i_lane], l_acc[i_lane]);
+                      }
+                  }
+              }
+              break;
+          case micro::op_code_exp:
+          case micro::op_code_log:
+          case micro::op_code_sin:
+          case micro::op_code_cos:
+          case micro::op_code_tanh:
+          case micro::op_code_pow:
+              if(inst.bit_flags == micro::tier_fast) {
+                  l_success = rt_approximate<micro::tier_fast>(inst.op_code, l_dst, l_src);
+              } else
+              if(inst.bit_flags == micro::tier_exact) {
+                  l_success = rt_approximate<micro::tier_exact>(inst.op_code, l_dst, l_src);
+              } else
+                  l_success = rt_approximate<micro::tier_default>(inst.op_code, l_dst, l_src);
+              break;
+          default:
+              return nullptr;
+      }
+      if(l_success == false) {
+          return nullptr;
+      }
+      return l_dst;
+}
+
+fptype* rt_run(const micro* code_head, const micro* code_tail, fptype* r_base) noexcept
+{
+      const micro* i_micro = code_head;
+      while(i_micro < code_tail) {
+          fptype* l_dst = rt_exec(*i_micro, r_base);
+          if(l_dst == nullptr) {
+              return nullptr;
+          }
+          if((i_micro->op_code == micro::op_code_ret) ||
+              (i_micro->bit_return)) {
+              return l_dst;
+          }
+          if(i_micro->bit_halt) {
+              return nullptr;
+          }
+          i_micro++;
+      }
+      return nullptr;
+}
+
+bool  rt_run_batch(const micro* code_head, const micro* code_tail, fptype* r_base, fptype* v_base) noexcept
+{
+      const micro* i_micro = code_head;
+      while(i_micro < code_tail) {
+          fptype* l_dst = rt_exec(*i_micro, r_base);
+          if(l_dst == nullptr) {
+              return false;
+          }
+          if(i_micro->bit_return) {
+              std::memcpy(v_base, l_dst, fpu::pts * sizeof(fptype));
+              v_base += fpu::pts;
+          } else
+          if(i_micro->bit_halt) {
+              return false;
+          }
+          i_micro++;
+      }
+      return true;
+}
+
 /*namespace dsp*/ }
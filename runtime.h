@@ -22,6 +22,9 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "dsp.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
 
 namespace dsp {
 
@@ -35,10 +38,27 @@ struct micro
   static constexpr unsigned int  op_code_mov = 0x02;
   static constexpr unsigned int  op_code_pos = 0x03;
   static constexpr unsigned int  op_code_neg = 0x04;
+  static constexpr unsigned int  op_code_abs = 0x05;
+  static constexpr unsigned int  op_code_sqrt = 0x06;
+  static constexpr unsigned int  op_code_msk = 0x07;      // all bits set where the operand is greater than zero, clear elsewhere
   static constexpr unsigned int  op_code_add = 0x08;
   static constexpr unsigned int  op_code_sub = 0x09;
   static constexpr unsigned int  op_code_mul = 0x0a;
   static constexpr unsigned int  op_code_div = 0x0b;
+  static constexpr unsigned int  op_code_min = 0x0c;
+  static constexpr unsigned int  op_code_max = 0x0d;
+  static constexpr unsigned int  op_code_pow = 0x0e;
+  static constexpr unsigned int  op_code_exp = 0x10;
+  static constexpr unsigned int  op_code_log = 0x11;
+  static constexpr unsigned int  op_code_sin = 0x12;
+  static constexpr unsigned int  op_code_cos = 0x13;
+  static constexpr unsigned int  op_code_tanh = 0x14;
+  static constexpr unsigned int  op_code_fma = 0x15;      // dst = dst * src.f.r + src.f.a
+  static constexpr unsigned int  op_code_fms = 0x16;      // dst = dst * src.f.r - src.f.a
+  static constexpr unsigned int  op_code_fnma = 0x17;     // dst = src.f.a - dst * src.f.r
+  static constexpr unsigned int  op_code_and = 0x18;
+  static constexpr unsigned int  op_code_andn = 0x19;     // clear the bits of src that are set in dst
+  static constexpr unsigned int  op_code_or = 0x1a;
   static constexpr unsigned int  op_code_nop = 0xff;
 
   unsigned int op_code:8;
@@ -52,11 +72,19 @@ struct micro
   static constexpr unsigned int  op_src_r = 1u;       // src is encoded as an offset into the register table
   static constexpr unsigned int  op_src_d = 2u;       // src is encoded as an offset into the data pointer
   static constexpr unsigned int  op_src_sp = 3u;      // src is encoded as a stack pointer offset
+  static constexpr unsigned int  op_src_rr = 4u;      // src is encoded as a pair of offsets into the register table
   static constexpr unsigned int  op_src_p = 7u;
   static constexpr unsigned int  op_src_i = 15u;
 
   unsigned int op_src:4;
 
+  /* tier_*
+   * accuracy tier of the approximated operations (exp, log, sin, cos, tanh, pow), stored in bit_flags
+  */
+  static constexpr unsigned int  tier_default = 0u;   // within a few ulp over the reduced range
+  static constexpr unsigned int  tier_fast = 1u;      // relative error in the order of 1e-4, shorter polynomials
+  static constexpr unsigned int  tier_exact = 2u;     // defer to the C library, one lane at a time
+
   unsigned int bit_flags:4;
 
   unsigned int bit_const:1;
@@ -71,6 +99,10 @@ struct micro
   union {
     int r;
     fptype* p;
+    struct {
+      int r;
+      int a;
+    } f;
   } src;
 };
 
@@ -78,5 +110,202 @@ inline bool is_return_micro(micro& inst) noexcept {
       return inst.op_code != micro::op_code_nop;
 }
 
+/* rt_fma()
+   x * y + z, fused into a single rounding where the target has a native instruction for it
+*/
+inline fptype rt_fma(fptype x, fptype y, fptype z) noexcept
+{
+#if defined(FP_FAST_FMAF)
+      return std::fma(x, y, z);
+#else
+      return x * y + z;
+#endif
+}
+
+/* rt_exp()
+   e^x, saturated to the [-87.3, 88] input range; the argument is split into n ln2 + r with |r| <= ln2/2 and e^r is
+   evaluated with a minimax polynomial
+*/
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_exp(fptype x) noexcept
+{
+      if constexpr (Tier == micro::tier_exact) {
+          return std::exp(x);
+      } else {
+          float l_x = static_cast<float>(x);
+          l_x = l_x < -87.3f ? -87.3f : l_x;
+          l_x = l_x > 88.0f ? 88.0f : l_x;
+          // round x / ln2 to the nearest integer by adding and removing 1.5 * 2^23
+          float l_t = l_x * 1.44269504f + 12582912.0f;
+          float l_n = l_t - 12582912.0f;
+          float l_r = l_x - l_n * 0.693359375f + l_n * 2.12194440e-4f;
+          float l_p;
+          if constexpr (Tier == micro::tier_fast) {
+              l_p = 1.0f + l_r * (1.0f + l_r * (0.5f + l_r * (1.66666667e-1f + l_r * 4.16666667e-2f)));
+          } else {
+              l_p = 1.9875691500e-4f;
+              l_p = l_p * l_r + 1.3981999507e-3f;
+              l_p = l_p * l_r + 8.3334519073e-3f;
+              l_p = l_p * l_r + 4.1665795894e-2f;
+              l_p = l_p * l_r + 1.6666665459e-1f;
+              l_p = l_p * l_r + 5.0000001201e-1f;
+              l_p = l_p * l_r * l_r + l_r + 1.0f;
+          }
+          std::int32_t l_e = std::bit_cast<std::int32_t>(l_t) - 0x4b400000;
+          return l_p * std::bit_cast<float>((l_e + 127) << 23);
+      }
+}
+
+/* rt_log()
+   natural logarithm; the mantissa is reduced to [sqrt(1/2), sqrt(2)) and log(1 + m) is evaluated with a minimax polynomial
+   (default) or the leading terms of the atanh series (fast); returns -inf for 0 and denormals, NaN for negative values
+*/
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_log(fptype x) noexcept
+{
+      if constexpr (Tier == micro::tier_exact) {
+          return std::log(x);
+      } else {
+          float         l_x = static_cast<float>(x);
+          std::int32_t  l_bits = std::bit_cast<std::int32_t>(l_x);
+          std::int32_t  l_e = ((l_bits >> 23) & 0xff) - 126;
+          float         l_m = std::bit_cast<float>((l_bits & 0x007fffff) | 0x3f000000);
+          bool          l_low = l_m < 0.707106781f;
+          l_e = l_low ? l_e - 1 : l_e;
+          l_m = l_low ? l_m + l_m - 1.0f : l_m - 1.0f;
+          float         l_f = static_cast<float>(l_e);
+          float         l_y;
+          if constexpr (Tier == micro::tier_fast) {
+              float l_s = l_m / (2.0f + l_m);
+              float l_z = l_s * l_s;
+              l_y = 2.0f * l_s * (1.0f + l_z * 3.33333333e-1f) + l_f * 0.693147181f;
+          } else {
+              float l_z = l_m * l_m;
+              float l_p = 7.0376836292e-2f;
+              l_p = l_p * l_m - 1.1514610310e-1f;
+              l_p = l_p * l_m + 1.1676998740e-1f;
+              l_p = l_p * l_m - 1.2420140846e-1f;
+              l_p = l_p * l_m + 1.4249322787e-1f;
+              l_p = l_p * l_m - 1.6668057665e-1f;
+              l_p = l_p * l_m + 2.0000714765e-1f;
+              l_p = l_p * l_m - 2.4999993993e-1f;
+              l_p = l_p * l_m + 3.3333331174e-1f;
+              l_y = l_m * l_z * l_p - 2.12194440e-4f * l_f - 0.5f * l_z;
+              l_y = l_m + l_y + 0.693359375f * l_f;
+          }
+          l_y = l_x <= 3.40282347e+38f ? l_y : l_x;
+          l_y = l_x < 1.17549435e-38f ? -INFINITY : l_y;
+          l_y = l_x < 0.0f ? NAN : l_y;
+          return l_y;
+      }
+}
+
+/* rt_sin_cos()
+   sine of x + q * pi / 2; the argument is reduced to |r| <= pi / 4 with a three part pi / 2 and the quadrant selects between
+   the sine and the cosine polynomials; accuracy degrades past |x| ~ 8192 pi
+*/
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_sin_cos(fptype x, std::int32_t q) noexcept
+{
+      float l_x = static_cast<float>(x);
+      float l_t = l_x * 0.636619772f + 12582912.0f;
+      float l_n = l_t - 12582912.0f;
+      std::int32_t l_q = std::bit_cast<std::int32_t>(l_t) - 0x4b400000 + q;
+      float l_r = ((l_x - l_n * 1.5703125f) - l_n * 4.8375129699707031e-4f) - l_n * 7.5497899548918821e-8f;
+      float l_z = l_r * l_r;
+      float l_s;
+      float l_c;
+      if constexpr (Tier == micro::tier_fast) {
+          l_s = l_r + l_r * l_z * (-1.66666667e-1f + l_z * 8.33333333e-3f);
+          l_c = 1.0f + l_z * (-0.5f + l_z * (4.16666667e-2f - l_z * 1.38888889e-3f));
+      } else {
+          l_s = l_r + l_r * l_z * (-1.6666654611e-1f + l_z * (8.3321608736e-3f - l_z * 1.9515295891e-4f));
+          l_c = 1.0f - 0.5f * l_z + l_z * l_z * (4.166664568298827e-2f + l_z * (-1.388731625493765e-3f + l_z * 2.443315711809948e-5f));
+      }
+      float l_y = (l_q & 1) ? l_c : l_s;
+      return (l_q & 2) ? -l_y : l_y;
+}
+
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_sin(fptype x) noexcept
+{
+      if constexpr (Tier == micro::tier_exact) {
+          return std::sin(x);
+      } else
+          return rt_sin_cos<Tier>(x, 0);
+}
+
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_cos(fptype x) noexcept
+{
+      if constexpr (Tier == micro::tier_exact) {
+          return std::cos(x);
+      } else
+          return rt_sin_cos<Tier>(x, 1);
+}
+
+/* rt_tanh()
+   hyperbolic tangent; an odd polynomial near the origin and 1 - 2 / (e^2|x| + 1) elsewhere
+*/
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_tanh(fptype x) noexcept
+{
+      if constexpr (Tier == micro::tier_exact) {
+          return std::tanh(x);
+      } else {
+          float l_x = static_cast<float>(x);
+          float l_a = std::fabs(l_x);
+          float l_z = l_x * l_x;
+          float l_p;
+          float l_q = 1.0f - 2.0f / (static_cast<float>(rt_exp<Tier>(l_a + l_a)) + 1.0f);
+          if constexpr (Tier == micro::tier_fast) {
+              l_p = l_x - l_x * l_z * 3.33333333e-1f;
+              l_a = l_a < 0.1f ? 0.0f : l_a;
+          } else {
+              l_p = -5.70498872745e-3f;
+              l_p = l_p * l_z + 2.06390887954e-2f;
+              l_p = l_p * l_z - 5.37397155531e-2f;
+              l_p = l_p * l_z + 1.33314422036e-1f;
+              l_p = l_p * l_z - 3.33332819422e-1f;
+              l_p = l_x + l_x * l_z * l_p;
+              l_a = l_a < 0.625f ? 0.0f : l_a;
+          }
+          return l_a == 0.0f ? l_p : std::copysign(l_q, l_x);
+      }
+}
+
+/* rt_pow()
+   x^y as e^(y log |x|); 0^y is 0, 1 or inf for positive, zero and negative y, negative bases are defined for integral
+   exponents only and give NaN elsewhere
+*/
+template<unsigned int Tier = micro::tier_default>
+inline fptype rt_pow(fptype x, fptype y) noexcept
+{
+      if constexpr (Tier == micro::tier_exact) {
+          return std::pow(x, y);
+      } else {
+          fptype l_y = rt_exp<Tier>(y * rt_log<Tier>(std::fabs(x)));
+          fptype l_z = y > 0 ? 0 : (y < 0 ? INFINITY : 1);
+          bool   l_integral = std::trunc(y) == y;
+          bool   l_odd = l_integral && (std::fabs(y) < 16777216) && (static_cast<std::int32_t>(y) & 1);
+          l_y = x < 0 ? (l_integral ? (l_odd ? -l_y : l_y) : NAN) : l_y;
+          l_y = x == 0 ? l_z : l_y;
+          l_y = y == 0 ? 1 : l_y;
+          return l_y;
+      }
+}
+
+/* rt_run()
+   execute the microcode in the [code_head, code_tail) range against the given register file and return the address of the
+   register holding the result, or nullptr if the code halted without producing one
+*/
+fptype* rt_run(const micro* code_head, const micro* code_tail, fptype* r_base) noexcept;
+
+/* rt_run_batch()
+   execute the code of several arguments laid out one after the other in a single pass, storing the result of each one into
+   the next vector of fpu::pts lanes at `v_base`; returns false if any of them fails to produce a result
+*/
+bool    rt_run_batch(const micro* code_head, const micro* code_tail, fptype* r_base, fptype* v_base) noexcept;
+
 /*namespace dsp*/ }
 #endif
@@ -0,0 +1,92 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "sink.h"
+
+namespace dsp {
+
+      sink::sink() noexcept:
+      sink(nullptr)
+{
+}
+
+      sink::sink(ring* ring_ptr) noexcept:
+      core(o_none),
+      m_input(this),
+      m_ring(ring_ptr),
+      m_overrun_count(0u)
+{
+}
+
+      sink::~sink()
+{
+}
+
+/* render()
+   push the input onto the ring; samples that don't fit are dropped and accounted for as an overrun
+*/
+bool  sink::render(unsigned int) noexcept
+{
+      fptype* l_data_ptr = m_input.get_return_vector();
+      if(l_data_ptr != nullptr) {
+          if(m_ring != nullptr) {
+              int l_size = dsp_get_sample_count() * dsp_get_sample_size();
+              int l_push;
+              if(int l_stride = dsp_get_channel_stride(); l_stride > 0) {
+                  // the ring carries interleaved frames
+                  fptype* l_frame_ptr = dsp_make_scratch_vector();
+                  if(l_frame_ptr == nullptr) {
+                      return false;
+                  }
+                  pcm_map(l_frame_ptr, dsp_get_sample_size(), 0, l_data_ptr, dsp_get_sample_size(), l_stride, dsp_get_sample_count());
+                  l_data_ptr = l_frame_ptr;
+              }
+              l_push = m_ring->write(l_data_ptr, l_size);
+              if(l_push < l_size) {
+                  m_overrun_count.fetch_add(1u, std::memory_order_relaxed);
+              }
+          }
+          return true;
+      }
+      return false;
+}
+
+gate& sink::get_input() noexcept
+{
+      return m_input;
+}
+
+ring* sink::get_ring() const noexcept
+{
+      return m_ring;
+}
+
+void  sink::set_ring(ring* ring_ptr) noexcept
+{
+      m_ring = ring_ptr;
+}
+
+unsigned int sink::get_overrun_count() const noexcept
+{
+      return m_overrun_count.load(std::memory_order_relaxed);
+}
+
+/*namespace dsp*/ }
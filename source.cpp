@@ -0,0 +1,100 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "source.h"
+
+namespace dsp {
+
+      source::source() noexcept:
+      source(nullptr)
+{
+}
+
+      source::source(ring* ring_ptr) noexcept:
+      core(o_none),
+      m_ring(ring_ptr),
+      m_underrun_count(0u)
+{
+}
+
+      source::~source()
+{
+}
+
+/* render()
+   pull the next vector from the ring
+*/
+bool  source::render(unsigned int op) noexcept
+{
+      int     l_size = dsp_get_sample_count() * dsp_get_sample_size();
+      int     l_pull = 0;
+      int     l_stride = dsp_get_channel_stride();
+      fptype* l_data_ptr;
+      if((op & op_render_additive) ||
+          (l_stride > 0)) {
+          l_data_ptr = dsp_make_scratch_vector();
+      } else
+          l_data_ptr = dsp_get_return_vector();
+      if(l_data_ptr != nullptr) {
+          if(m_ring != nullptr) {
+              l_pull = m_ring->read(l_data_ptr, l_size);
+          }
+          if(l_pull < l_size) {
+              pcm_clr(l_data_ptr + l_pull, l_size - l_pull);
+              m_underrun_count.fetch_add(1u, std::memory_order_relaxed);
+          }
+          if(l_stride > 0) {
+              // the ring carries interleaved frames
+              pcm_map(
+                  dsp_get_return_vector(),
+                  dsp_get_sample_size(),
+                  l_stride,
+                  l_data_ptr,
+                  dsp_get_sample_size(),
+                  0,
+                  dsp_get_sample_count(),
+                  op & op_render_additive
+              );
+          } else
+          if(op & op_render_additive) {
+              pcm_add(dsp_get_return_vector(), l_data_ptr, l_size);
+          }
+          return true;
+      }
+      return false;
+}
+
+ring* source::get_ring() const noexcept
+{
+      return m_ring;
+}
+
+void  source::set_ring(ring* ring_ptr) noexcept
+{
+      m_ring = ring_ptr;
+}
+
+unsigned int source::get_underrun_count() const noexcept
+{
+      return m_underrun_count.load(std::memory_order_relaxed);
+}
+
+/*namespace dsp*/ }
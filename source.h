@@ -0,0 +1,59 @@
+#ifndef dsp_source_h
+#define dsp_source_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include "ring.h"
+
+namespace dsp {
+
+/* source
+   consumer end of a render-thread bridge: renders the samples pushed into a ring by a `sink` node; never blocks - when the
+   ring runs dry the rest of the vector is filled with silence and the event is accounted for as an underrun
+*/
+class source: public core
+{
+  ring*         m_ring;
+  std::atomic<unsigned int>  m_underrun_count;
+
+  protected:
+  virtual bool  render(unsigned int) noexcept override;
+
+  public:
+          source() noexcept;
+          source(ring*) noexcept;
+          source(const source&) noexcept = delete;
+          source(source&&) noexcept = delete;
+  virtual ~source();
+
+          ring* get_ring() const noexcept;
+          void  set_ring(ring*) noexcept;
+
+          unsigned int get_underrun_count() const noexcept;
+
+          source& operator=(const source&) noexcept = delete;
+          source& operator=(source&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
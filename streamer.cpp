@@ -0,0 +1,168 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "streamer.h"
+#include "player.h"
+
+namespace dsp {
+
+      streamer::streamer() noexcept:
+      m_player_head(nullptr),
+      m_block_ptr(nullptr),
+      m_block_size(0),
+      m_run(false),
+      m_idle(false),
+      m_wake(0u),
+      m_pass_count(0u)
+{
+}
+
+      streamer::~streamer()
+{
+      stop();
+      while(m_player_head != nullptr) {
+          detach(m_player_head);
+      }
+}
+
+/* dsp_stream_run()
+   streaming thread: top up the voice rings of all the attached players, sleep when there was nothing to do
+*/
+void  streamer::dsp_stream_run() noexcept
+{
+      while(m_run.load()) {
+          unsigned int l_wake = m_wake.load();
+          bool         l_progress = false;
+          m_player_lock.lock();
+          player* i_player = m_player_head;
+          while(i_player != nullptr) {
+              if(i_player->dsp_fetch(m_block_ptr, m_block_size)) {
+                  l_progress = true;
+              }
+              i_player = i_player->m_player_next;
+          }
+          m_player_lock.unlock();
+          m_pass_count.fetch_add(1u, std::memory_order_relaxed);
+          if(l_progress == false) {
+              m_idle.store(true);
+              m_wake.wait(l_wake);
+              m_idle.store(false);
+          }
+      }
+}
+
+/* attach()
+   start streaming for the given player; the player needs to be open
+*/
+bool  streamer::attach(player* player_ptr) noexcept
+{
+      if(player_ptr != nullptr) {
+          if(player_ptr->m_streamer == nullptr) {
+              if(player_ptr->is_open()) {
+                  m_player_lock.lock();
+                  player_ptr->m_player_next = m_player_head;
+                  player_ptr->m_streamer = this;
+                  m_player_head = player_ptr;
+                  m_player_lock.unlock();
+                  wake();
+                  return true;
+              }
+          }
+      }
+      return false;
+}
+
+/* detach()
+   stop streaming for the given player; once detach() returns the streaming thread no longer touches the player
+*/
+bool  streamer::detach(player* player_ptr) noexcept
+{
+      if(player_ptr != nullptr) {
+          if(player_ptr->m_streamer == this) {
+              m_player_lock.lock();
+              player** p_link = std::addressof(m_player_head);
+              while(*p_link != nullptr) {
+                  if(*p_link == player_ptr) {
+                      *p_link = player_ptr->m_player_next;
+                      break;
+                  }
+                  p_link = std::addressof((*p_link)->m_player_next);
+              }
+              player_ptr->m_player_next = nullptr;
+              player_ptr->m_streamer = nullptr;
+              m_player_lock.unlock();
+              return true;
+          }
+      }
+      return false;
+}
+
+bool  streamer::start() noexcept
+{
+      if(m_run.load() == false) {
+          m_block_ptr = reinterpret_cast<fptype*>(malloc(streamer_block_frames * sizeof(fptype)));
+          if(m_block_ptr != nullptr) {
+              m_block_size = streamer_block_frames;
+              m_pass_count.store(0u);
+              m_run.store(true);
+              m_thread = std::thread(&streamer::dsp_stream_run, this);
+              return true;
+          }
+      }
+      return false;
+}
+
+/* wake()
+   let the streaming thread know there might be work to do; called from the render thread, only enters the kernel when the
+   streaming thread is asleep
+*/
+void  streamer::wake() noexcept
+{
+      m_wake.fetch_add(1u);
+      if(m_idle.load()) {
+          m_wake.notify_one();
+      }
+}
+
+void  streamer::stop() noexcept
+{
+      if(m_run.load()) {
+          m_run.store(false);
+          m_wake.fetch_add(1u);
+          m_wake.notify_one();
+          m_thread.join();
+          free(m_block_ptr);
+          m_block_ptr = nullptr;
+          m_block_size = 0;
+      }
+}
+
+unsigned int streamer::get_pass_count() const noexcept
+{
+      return m_pass_count.load(std::memory_order_relaxed);
+}
+
+bool  streamer::is_running() const noexcept
+{
+      return m_run.load(std::memory_order_relaxed);
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,75 @@
+#ifndef dsp_streamer_h
+#define dsp_streamer_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "config.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace dsp {
+
+class player;
+
+/* streamer
+   background i/o thread feeding the voice rings of streaming players; any page faults and decoding costs are taken here,
+   away from the render thread, which only ever reads the rings; the thread sleeps until it is woken by a player that has
+   voices streaming or by a new play command
+*/
+class streamer
+{
+  player*       m_player_head;
+  std::mutex    m_player_lock;      // held by the streaming thread while it walks the player list
+  fptype*       m_block_ptr;
+  int           m_block_size;
+  std::thread   m_thread;
+  std::atomic<bool>          m_run;
+  std::atomic<bool>          m_idle;
+  std::atomic<unsigned int>  m_wake;
+  std::atomic<unsigned int>  m_pass_count;
+
+  protected:
+          void    dsp_stream_run() noexcept;
+
+  public:
+          streamer() noexcept;
+          streamer(const streamer&) noexcept = delete;
+          streamer(streamer&&) noexcept = delete;
+          ~streamer();
+
+          bool    attach(player*) noexcept;
+          bool    detach(player*) noexcept;
+
+          bool    start() noexcept;
+          void    wake() noexcept;
+          void    stop() noexcept;
+
+          unsigned int get_pass_count() const noexcept;
+          bool    is_running() const noexcept;
+
+          streamer& operator=(const streamer&) noexcept = delete;
+          streamer& operator=(streamer&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
@@ -0,0 +1,194 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "svf.h"
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace dsp {
+
+/* svf_run()
+   filter `frames` frames of `Lanes` channels through the cascade; the loop over the lanes is the one that vectorises
+*/
+template<int Lanes>
+static void svf_run(
+          fptype* dp, int dp_stride, const fptype* sp, int sp_stride, int frames, int stages,
+          const fptype (*coeff)[filter::lane_max], fptype* state, bool additive
+      ) noexcept
+{
+      for(int i_frame = 0; i_frame < frames; i_frame++) {
+          fptype l_x[Lanes];
+          for(int i_lane = 0; i_lane < Lanes; i_lane++) {
+              if(sp_stride > 0) {
+                  l_x[i_lane] = sp[i_lane * sp_stride + i_frame];
+              } else
+                  l_x[i_lane] = sp[i_frame * Lanes + i_lane];
+          }
+          for(int i_stage = 0; i_stage < stages; i_stage++) {
+              fptype* p_ic1 = state + i_stage * filter::lane_max * 2;
+              fptype* p_ic2 = p_ic1 + filter::lane_max;
+              for(int i_lane = 0; i_lane < Lanes; i_lane++) {
+                  fptype l_v3 = l_x[i_lane] - p_ic2[i_lane];
+                  fptype l_v1 = coeff[0][i_lane] * p_ic1[i_lane] + coeff[1][i_lane] * l_v3;
+                  fptype l_v2 = p_ic2[i_lane] + coeff[1][i_lane] * p_ic1[i_lane] + coeff[2][i_lane] * l_v3;
+                  p_ic1[i_lane] = 2.0f * l_v1 - p_ic1[i_lane];
+                  p_ic2[i_lane] = 2.0f * l_v2 - p_ic2[i_lane];
+                  l_x[i_lane] = coeff[3][i_lane] * l_x[i_lane] + coeff[4][i_lane] * l_v1 + coeff[5][i_lane] * l_v2;
+              }
+          }
+          for(int i_lane = 0; i_lane < Lanes; i_lane++) {
+              fptype* p_y;
+              if(dp_stride > 0) {
+                  p_y = dp + i_lane * dp_stride + i_frame;
+              } else
+                  p_y = dp + i_frame * Lanes + i_lane;
+              if(additive) {
+                  *p_y += l_x[i_lane];
+              } else
+                  *p_y = l_x[i_lane];
+          }
+      }
+}
+
+      svf::svf() noexcept:
+      svf(1, 1)
+{
+}
+
+      svf::svf(int lanes, int stages) noexcept:
+      filter(lanes, stages),
+      m_state(nullptr)
+{
+      std::memset(m_coeff, 0, sizeof(m_coeff));
+      m_state = reinterpret_cast<fptype*>(malloc(m_stage_count * lane_max * 2 * sizeof(fptype)));
+      reset();
+}
+
+      svf::~svf()
+{
+      free(m_state);
+}
+
+void  svf::dsp_update(int lane, const param_t& param, float rate) noexcept
+{
+      double l_g = std::tan(std::numbers::pi * param.frequency / rate);
+      double l_k = 1.0 / param.q;
+      double l_a = std::pow(10.0, param.gain / 40.0);
+      double l_m0 = 0.0;
+      double l_m1 = 0.0;
+      double l_m2 = 0.0;
+      switch(param.shape) {
+          case shape_lowpass:
+              l_m2 = 1.0;
+              break;
+          case shape_highpass:
+              l_m0 = 1.0;
+              l_m1 = -l_k;
+              l_m2 = -1.0;
+              break;
+          case shape_bandpass:
+              l_m1 = 1.0;
+              break;
+          case shape_notch:
+              l_m0 = 1.0;
+              l_m1 = -l_k;
+              break;
+          case shape_allpass:
+              l_m0 = 1.0;
+              l_m1 = -2.0 * l_k;
+              break;
+          case shape_peak:
+              l_k = 1.0 / (param.q * l_a);
+              l_m0 = 1.0;
+              l_m1 = l_k * (l_a * l_a - 1.0);
+              break;
+          case shape_lowshelf:
+              l_g /= std::sqrt(l_a);
+              l_m0 = 1.0;
+              l_m1 = l_k * (l_a - 1.0);
+              l_m2 = l_a * l_a - 1.0;
+              break;
+          case shape_highshelf:
+              l_g *= std::sqrt(l_a);
+              l_m0 = l_a * l_a;
+              l_m1 = l_k * (1.0 - l_a) * l_a;
+              l_m2 = 1.0 - l_a * l_a;
+              break;
+      }
+      double l_a1 = 1.0 / (1.0 + l_g * (l_g + l_k));
+      double l_a2 = l_g * l_a1;
+      double l_a3 = l_g * l_a2;
+      m_coeff[0][lane] = l_a1;
+      m_coeff[1][lane] = l_a2;
+      m_coeff[2][lane] = l_a3;
+      m_coeff[3][lane] = l_m0;
+      m_coeff[4][lane] = l_m1;
+      m_coeff[5][lane] = l_m2;
+}
+
+bool  svf::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      int     l_stride = dsp_get_channel_stride();
+      bool    l_additive = op & op_render_additive;
+      fptype* l_input_ptr = m_input.get_return_vector();
+      fptype* l_output_ptr = dsp_get_return_vector();
+      if((m_state == nullptr) ||
+          (dsp_prepare() == false)) {
+          return false;
+      }
+      if(l_input_ptr == nullptr) {
+          if(l_additive == false) {
+              pcm_clr(l_output_ptr, dsp_get_vector_size());
+          }
+          return true;
+      }
+      switch(m_lane_count) {
+          case 1:
+              svf_run<1>(l_output_ptr, l_stride, l_input_ptr, l_stride, l_frames, m_stage_count, m_coeff, m_state, l_additive);
+              break;
+          case 2:
+              svf_run<2>(l_output_ptr, l_stride, l_input_ptr, l_stride, l_frames, m_stage_count, m_coeff, m_state, l_additive);
+              break;
+          case 4:
+              svf_run<4>(l_output_ptr, l_stride, l_input_ptr, l_stride, l_frames, m_stage_count, m_coeff, m_state, l_additive);
+              break;
+          case 8:
+              svf_run<8>(l_output_ptr, l_stride, l_input_ptr, l_stride, l_frames, m_stage_count, m_coeff, m_state, l_additive);
+              break;
+          default:
+              return false;
+      }
+      return true;
+}
+
+/* reset()
+   clear the filter state of all the lanes
+*/
+void  svf::reset() noexcept
+{
+      if(m_state != nullptr) {
+          std::memset(m_state, 0, m_stage_count * lane_max * 2 * sizeof(fptype));
+      }
+}
+
+/*namespace dsp*/ }
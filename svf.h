@@ -0,0 +1,56 @@
+#ifndef dsp_svf_h
+#define dsp_svf_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "filter.h"
+
+namespace dsp {
+
+/* svf
+   bank of cascaded state variable filters, trapezoidal integration (zero delay feedback) form; the response is a mix of
+   the input and the band and low pass outputs, which keeps the filter well behaved under fast parameter changes
+*/
+class svf: public filter
+{
+  alignas(32) fptype m_coeff[6][lane_max];      // a1, a2, a3 and the m0, m1, m2 mix of each lane
+  fptype*   m_state;                            // ic1, ic2 of each lane, for each stage
+
+  protected:
+  virtual void    dsp_update(int, const param_t&, float) noexcept override;
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          svf() noexcept;
+          svf(int, int = 1) noexcept;
+          svf(const svf&) noexcept = delete;
+          svf(svf&&) noexcept = delete;
+  virtual ~svf();
+
+  virtual void    reset() noexcept override;
+
+          svf&    operator=(const svf&) noexcept = delete;
+          svf&    operator=(svf&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
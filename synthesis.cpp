@@ -0,0 +1,151 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "synthesis.h"
+#include "analysis.h"
+#include "table.h"
+#include <cmath>
+#include <numbers>
+
+namespace dsp {
+
+      synthesis::synthesis() noexcept:
+      synthesis(stft_frame_size)
+{
+}
+
+      synthesis::synthesis(int size) noexcept:
+      core(o_none),
+      m_input(this),
+      m_fft(size),
+      m_hop(0),
+      m_position(0),
+      m_window(nullptr)
+{
+      set_sample_format(fmt_pcm_1);
+      set_input_format(fmt_apm);
+      if(m_fft.is_valid()) {
+          int  l_bins = m_fft.get_bin_count();
+          auto l_window = reinterpret_cast<const fptype*>(tbl_acquire(tbl_window, size, size * sizeof(fptype), stft_build_window));
+          auto l_data = reinterpret_cast<fptype*>(malloc((size * 2 + l_bins * 4) * sizeof(fptype)));
+          if((l_window != nullptr) &&
+              (l_data != nullptr)) {
+              m_hop = size / 2;
+              m_window = l_window;
+              m_spectrum = l_data;
+              m_frame = m_spectrum + l_bins * 2;
+              m_overlap = m_frame + size;
+              m_output = m_overlap + m_hop;
+              m_bins_re = m_output + m_hop;
+              m_bins_im = m_bins_re + l_bins;
+              pcm_clr(m_spectrum, l_bins * 2);
+              pcm_clr(m_overlap, m_hop);
+              pcm_clr(m_output, m_hop);
+          } else
+          if(true) {
+              tbl_release(l_window);
+              free(l_data);
+          }
+      }
+}
+
+      synthesis::~synthesis()
+{
+      if(m_window != nullptr) {
+          tbl_release(m_window);
+          free(m_spectrum);
+      }
+}
+
+/* dsp_synthesise()
+   transform the collected spectrum back and overlap-add it onto the output; the DC slot is split back into the DC and
+   Nyquist bins first, such that all `size / 2 + 1` bins go into the inverse transform
+*/
+void  synthesis::dsp_synthesise() noexcept
+{
+      int l_bins = m_fft.get_bin_count();
+      m_spectrum[m_hop * 2] = m_spectrum[0] * std::sin(m_spectrum[1]);
+      m_spectrum[m_hop * 2 + 1] = 0.0f;
+      m_spectrum[0] = m_spectrum[0] * std::cos(m_spectrum[1]);
+      m_spectrum[1] = 0.0f;
+      for(int i_bin = 0; i_bin < l_bins; i_bin++) {
+          fptype l_amplitude = m_spectrum[i_bin * 2];
+          fptype l_phase = m_spectrum[i_bin * 2 + 1];
+          m_bins_re[i_bin] = l_amplitude * std::cos(l_phase);
+          m_bins_im[i_bin] = l_amplitude * std::sin(l_phase);
+      }
+      m_fft.inverse(m_bins_re, m_bins_im, m_frame);
+      for(int i_index = 0; i_index < m_hop; i_index++) {
+          m_output[i_index] = m_overlap[i_index] + m_frame[i_index] * m_window[i_index];
+          m_overlap[i_index] = m_frame[m_hop + i_index] * m_window[m_hop + i_index];
+      }
+}
+
+bool  synthesis::render(unsigned int op) noexcept
+{
+      int     l_frames = dsp_get_sample_count();
+      fptype* l_input_ptr = m_input.get_return_vector();
+      fptype* l_output_ptr = dsp_get_return_vector();
+      if(m_window == nullptr) {
+          return false;
+      }
+      for(int i_frame = 0; i_frame < l_frames; i_frame++) {
+          if(l_input_ptr != nullptr) {
+              m_spectrum[m_position * 2] = l_input_ptr[i_frame * 2];
+              m_spectrum[m_position * 2 + 1] = l_input_ptr[i_frame * 2 + 1];
+          } else
+          if(true) {
+              m_spectrum[m_position * 2] = 0.0f;
+              m_spectrum[m_position * 2 + 1] = 0.0f;
+          }
+          if(op & op_render_additive) {
+              l_output_ptr[i_frame] += m_output[m_position];
+          } else
+              l_output_ptr[i_frame] = m_output[m_position];
+          if(++m_position == m_hop) {
+              dsp_synthesise();
+              m_position = 0;
+          }
+      }
+      return true;
+}
+
+gate& synthesis::get_input() noexcept
+{
+      return m_input;
+}
+
+int   synthesis::get_frame_size() const noexcept
+{
+      return m_fft.get_size();
+}
+
+int   synthesis::get_hop_size() const noexcept
+{
+      return m_hop;
+}
+
+bool  synthesis::is_valid() const noexcept
+{
+      return m_window != nullptr;
+}
+
+/*namespace dsp*/ }
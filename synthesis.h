@@ -0,0 +1,70 @@
+#ifndef dsp_synthesis_h
+#define dsp_synthesis_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "core.h"
+#include "fft.h"
+
+namespace dsp {
+
+/* synthesis
+   inverse short-time fourier transform: turns an amplitude/phase (`fmt_apm`) stream laid out the way `analysis` emits it
+   back into mono PCM, by windowed overlap-add; an `analysis` and `synthesis` pair of the same size reconstructs its input
+   delayed by `size * 3 / 2` samples
+*/
+class synthesis: public core
+{
+  gate      m_input;
+  fft       m_fft;
+  int       m_hop;
+  int       m_position;
+  const fptype* m_window;
+  fptype*   m_spectrum;       // (amplitude, phase) pairs of all bins, the first `size / 2` of which are being collected
+  fptype*   m_bins_re;
+  fptype*   m_bins_im;
+  fptype*   m_frame;
+  fptype*   m_overlap;        // second half of the previous frame
+  fptype*   m_output;         // samples being emitted
+
+  protected:
+          void    dsp_synthesise() noexcept;
+  virtual bool    render(unsigned int) noexcept override;
+
+  public:
+          synthesis() noexcept;
+          synthesis(int) noexcept;
+          synthesis(const synthesis&) noexcept = delete;
+          synthesis(synthesis&&) noexcept = delete;
+  virtual ~synthesis();
+
+          gate&   get_input() noexcept;
+          int     get_frame_size() const noexcept;
+          int     get_hop_size() const noexcept;
+          bool    is_valid() const noexcept;
+
+          synthesis& operator=(const synthesis&) noexcept = delete;
+          synthesis& operator=(synthesis&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif
@@ -0,0 +1,161 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "table.h"
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+namespace dsp {
+
+/* tbl_entry_t
+   header of a table: the key is stored right after it, and the table data at `data_offset` bytes from the start of the
+   entry
+*/
+struct tbl_entry_t
+{
+  std::uint64_t   hash;
+  unsigned int    kind;
+  int             refs;
+  std::size_t     key_size;
+  std::size_t     data_size;
+  std::size_t     data_offset;
+  tbl_entry_t*    next;
+};
+
+static constexpr std::size_t tbl_align = memory_vector_block * sizeof(fptype);
+
+static tbl_entry_t*  s_tbl_head = nullptr;
+static int           s_tbl_count = 0;
+static std::size_t   s_tbl_size = 0;
+/* generators may themselves depend on other tables (a wavetable on the fft twiddles), so the lock has to be reentrant */
+static std::recursive_mutex s_tbl_lock;
+
+/* tbl_hash()
+   FNV-1a over the kind and the key
+*/
+static std::uint64_t tbl_hash(unsigned int kind, const void* key, std::size_t key_size) noexcept
+{
+      std::uint64_t l_hash = 14695981039346656037ull;
+      auto p_byte = reinterpret_cast<const std::uint8_t*>(key);
+      for(int i_byte = 0; i_byte < 4; i_byte++) {
+          l_hash = (l_hash ^ ((kind >> (i_byte * 8)) & 255u)) * 1099511628211ull;
+      }
+      for(std::size_t i_byte = 0; i_byte < key_size; i_byte++) {
+          l_hash = (l_hash ^ p_byte[i_byte]) * 1099511628211ull;
+      }
+      return l_hash;
+}
+
+static inline void* tbl_get_data(tbl_entry_t* entry) noexcept
+{
+      return reinterpret_cast<char*>(entry) + entry->data_offset;
+}
+
+/* tbl_acquire()
+   get a reference to the table of the given kind and key, of `size` bytes, building it with `build` if it isn't in the store
+   yet; returns nullptr if the table can't be built
+*/
+const void*  tbl_acquire(unsigned int kind, const void* key, std::size_t key_size, std::size_t size, tbl_build_t build, void* context) noexcept
+{
+      std::lock_guard<std::recursive_mutex> l_lock(s_tbl_lock);
+      std::uint64_t l_hash = tbl_hash(kind, key, key_size);
+      tbl_entry_t*  i_entry = s_tbl_head;
+      while(i_entry != nullptr) {
+          if((i_entry->hash == l_hash) &&
+              (i_entry->kind == kind) &&
+              (i_entry->key_size == key_size) &&
+              (i_entry->data_size == size) &&
+              (std::memcmp(i_entry + 1, key, key_size) == 0)) {
+              i_entry->refs++;
+              return tbl_get_data(i_entry);
+          }
+          i_entry = i_entry->next;
+      }
+      std::size_t l_data_offset = get_round_value(sizeof(tbl_entry_t) + key_size, tbl_align);
+      std::size_t l_entry_size = get_round_value(l_data_offset + size, tbl_align);
+      auto p_entry = reinterpret_cast<tbl_entry_t*>(aligned_alloc(tbl_align, l_entry_size));
+      if(p_entry == nullptr) {
+          return nullptr;
+      }
+      p_entry->hash = l_hash;
+      p_entry->kind = kind;
+      p_entry->refs = 1;
+      p_entry->key_size = key_size;
+      p_entry->data_size = size;
+      p_entry->data_offset = l_data_offset;
+      std::memcpy(p_entry + 1, key, key_size);
+      if(build(tbl_get_data(p_entry), size, key, context) == false) {
+          free(p_entry);
+          return nullptr;
+      }
+      p_entry->next = s_tbl_head;
+      s_tbl_head = p_entry;
+      s_tbl_count++;
+      s_tbl_size += l_entry_size;
+      return tbl_get_data(p_entry);
+}
+
+/* tbl_release()
+   drop a reference to a table; the table is freed along with the last one
+*/
+void  tbl_release(const void* data) noexcept
+{
+      if(data == nullptr) {
+          return;
+      }
+      std::lock_guard<std::recursive_mutex> l_lock(s_tbl_lock);
+      tbl_entry_t** p_link = std::addressof(s_tbl_head);
+      while(*p_link != nullptr) {
+          tbl_entry_t* p_entry = *p_link;
+          if(tbl_get_data(p_entry) == data) {
+              if(--p_entry->refs == 0) {
+                  *p_link = p_entry->next;
+                  s_tbl_count--;
+                  s_tbl_size -= get_round_value(p_entry->data_offset + p_entry->data_size, tbl_align);
+                  free(p_entry);
+              }
+              return;
+          }
+          p_link = std::addressof(p_entry->next);
+      }
+      printdbg("Table `%p` is not in the store.\n", __FILE__, __LINE__, data);
+}
+
+/* tbl_get_count()
+   number of tables in the store
+*/
+int   tbl_get_count() noexcept
+{
+      std::lock_guard<std::recursive_mutex> l_lock(s_tbl_lock);
+      return s_tbl_count;
+}
+
+/* tbl_get_size()
+   memory held by the store, in bytes
+*/
+std::size_t  tbl_get_size() noexcept
+{
+      std::lock_guard<std::recursive_mutex> l_lock(s_tbl_lock);
+      return s_tbl_size;
+}
+
+/*namespace dsp*/ }
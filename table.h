@@ -0,0 +1,61 @@
+#ifndef dsp_table_h
+#define dsp_table_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "config.h"
+#include <cstddef>
+
+namespace dsp {
+
+/* tbl_*
+   shared store for large read-only tables (fft twiddles, wavetables, windows, filter kernels): a table is addressed by its
+   kind and by the parameters it is generated from, built on first use and shared, by reference count, between all the
+   nodes and voices of all the apus in the process; the memory is aligned to `memory_vector_block` samples and never moves
+   for as long as a reference is held
+*/
+static constexpr unsigned int tbl_fft = 1u;             // key: transform size (int)
+static constexpr unsigned int tbl_wavetable = 2u;       // key: amplitudes of the harmonics
+static constexpr unsigned int tbl_window = 3u;          // key: window size (int)
+static constexpr unsigned int tbl_kernel = 4u;          // key: kernel design parameters
+
+/* tbl_build_t
+   table generator: fills `size` bytes at `data` from the `key`; `context` is passed on from tbl_acquire()
+*/
+using tbl_build_t = bool (*)(void* data, std::size_t size, const void* key, void* context) noexcept;
+
+const void*  tbl_acquire(unsigned int, const void*, std::size_t, std::size_t, tbl_build_t, void* = nullptr) noexcept;
+void         tbl_release(const void*) noexcept;
+int          tbl_get_count() noexcept;
+std::size_t  tbl_get_size() noexcept;
+
+/* tbl_acquire()
+   shorthand for tables whose key is a single trivially copyable value
+*/
+template<typename Kt>
+inline const void* tbl_acquire(unsigned int kind, const Kt& key, std::size_t size, tbl_build_t build, void* context = nullptr) noexcept
+{
+      return tbl_acquire(kind, std::addressof(key), sizeof(Kt), size, build, context);
+}
+
+/*namespace dsp*/ }
+#endif
@@ -40,6 +40,7 @@ class uniform: public symbol
   static constexpr int used_instruction_count = 1;
 
   friend class factory;
+  friend class atom;
 
   public:
           uniform() noexcept;
@@ -0,0 +1,185 @@
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "wavetable.h"
+#include "fft.h"
+#include "table.h"
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace dsp {
+
+static wavetable*  s_sine_table = nullptr;
+static std::mutex  s_sine_lock;
+
+      wavetable::wavetable() noexcept:
+      m_data(nullptr),
+      m_level_count(0),
+      m_refs(1)
+{
+}
+
+      wavetable::~wavetable()
+{
+      tbl_release(m_data);
+}
+
+/* wavetable_build()
+   table store generator for the levels of a table, from the amplitudes of its harmonics, the first one being the
+   fundamental; each level is the inverse transform of the harmonics that fit under its limit
+*/
+static bool  wavetable_build(void* data, std::size_t, const void* key, void* context) noexcept
+{
+      constexpr int l_half = wavetable_size / 2;
+      constexpr int l_level_count = std::countr_zero(static_cast<unsigned int>(l_half)) + 1;
+      auto  p_data = reinterpret_cast<fptype*>(data);
+      auto  p_harmonics = reinterpret_cast<const fptype*>(key);
+      int   l_count = *reinterpret_cast<int*>(context);
+      fft   l_fft(wavetable_size);
+      auto  p_work = reinterpret_cast<fptype*>(malloc((l_half + 1) * 2 * sizeof(fptype)));
+      if((p_work == nullptr) ||
+          (l_fft.is_valid() == false)) {
+          free(p_work);
+          return false;
+      }
+      fptype* p_re = p_work;
+      fptype* p_im = p_work + l_half + 1;
+      for(int i_level = 0; i_level < l_level_count; i_level++) {
+          fptype* p_level = p_data + i_level * (wavetable_size + 1);
+          int     l_limit = l_half >> i_level;
+          std::memset(p_work, 0, (l_half + 1) * 2 * sizeof(fptype));
+          for(int i_harmonic = 1; (i_harmonic <= l_count) && (i_harmonic <= l_limit) && (i_harmonic < l_half); i_harmonic++) {
+              // sine phase: the transform of `sin(2 pi h n / N)` is `-i N / 2` at bin h
+              p_im[i_harmonic] = 0.0f - p_harmonics[i_harmonic - 1] * l_half;
+          }
+          l_fft.inverse(p_re, p_im, p_level);
+          p_level[wavetable_size] = p_level[0];
+      }
+      free(p_work);
+      return true;
+}
+
+/* dsp_build()
+   get the levels for the given harmonics from the table store; tables made from the same harmonics share their levels
+*/
+bool  wavetable::dsp_build(const fptype* harmonics, int count) noexcept
+{
+      constexpr int l_level_count = std::countr_zero(static_cast<unsigned int>(wavetable_size / 2)) + 1;
+      auto  p_data = reinterpret_cast<const fptype*>(
+          tbl_acquire(
+              tbl_wavetable,
+              harmonics,
+              count * sizeof(fptype),
+              l_level_count * (wavetable_size + 1) * sizeof(fptype),
+              wavetable_build,
+              std::addressof(count)
+          )
+      );
+      if(p_data == nullptr) {
+          return false;
+      }
+      tbl_release(m_data);
+      m_data = p_data;
+      m_level_count = l_level_count;
+      return true;
+}
+
+/* make()
+   build a table out of the amplitudes of its harmonics; the table is returned with a single reference held by the caller
+*/
+wavetable* wavetable::make(const fptype* harmonics, int count) noexcept
+{
+      auto p_table = reinterpret_cast<wavetable*>(malloc(sizeof(wavetable)));
+      if(p_table != nullptr) {
+          new(p_table) wavetable;
+          if(p_table->dsp_build(harmonics, count) == false) {
+              p_table->~wavetable();
+              free(p_table);
+              return nullptr;
+          }
+      }
+      return p_table;
+}
+
+/* make_sine()
+   get a reference to the process wide sine table; the table itself holds on to one reference, so it's never rebuilt
+*/
+wavetable* wavetable::make_sine() noexcept
+{
+      std::lock_guard<std::mutex> l_lock(s_sine_lock);
+      if(s_sine_table == nullptr) {
+          fptype l_fundamental = 1.0f;
+          s_sine_table = make(std::addressof(l_fundamental), 1);
+          if(s_sine_table == nullptr) {
+              return nullptr;
+          }
+      }
+      return s_sine_table->acquire();
+}
+
+wavetable* wavetable::acquire() noexcept
+{
+      m_refs.fetch_add(1, std::memory_order_relaxed);
+      return this;
+}
+
+/* release()
+   drop a reference; the table is destroyed along with the last one
+*/
+void  wavetable::release() noexcept
+{
+      if(m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          this->~wavetable();
+          free(this);
+      }
+}
+
+/* get_level()
+   get the most detailed level that doesn't alias when played at `increment` cycles per sample
+*/
+const fptype* wavetable::get_level(double increment) const noexcept
+{
+      int    l_level = 0;
+      double l_limit = wavetable_size / 2;
+      if(increment < 0.0) {
+          increment = 0.0 - increment;
+      }
+      while((l_level < m_level_count - 1) &&
+          (l_limit * increment > 0.5)) {
+          l_limit *= 0.5;
+          l_level++;
+      }
+      return m_data + l_level * (wavetable_size + 1);
+}
+
+int   wavetable::get_level_count() const noexcept
+{
+      return m_level_count;
+}
+
+int   wavetable::get_size() const noexcept
+{
+      return wavetable_size;
+}
+
+/*namespace dsp*/ }
@@ -0,0 +1,66 @@
+#ifndef dsp_wavetable_h
+#define dsp_wavetable_h
+/** 
+    Copyright (c) 2022, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following 
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dsp.h"
+#include "config.h"
+#include <atomic>
+
+namespace dsp {
+
+/* wavetable
+   single cycle waveform, mip-mapped by octave: level `k` holds the harmonics up to `wavetable_size / 2 >> k`, such that
+   a level can be picked for any pitch that doesn't alias; tables are immutable once built and reference counted, so
+   that a single copy can be shared by any number of oscillators, and the levels themselves live in the table store, so
+   that tables made from the same harmonics share them
+*/
+class wavetable
+{
+  const fptype* m_data;           // levels of `wavetable_size + 1` samples; the last sample repeats the first one
+  int       m_level_count;
+  std::atomic<int> m_refs;
+
+  protected:
+          bool    dsp_build(const fptype*, int) noexcept;
+
+  public:
+          wavetable() noexcept;
+          wavetable(const wavetable&) noexcept = delete;
+          wavetable(wavetable&&) noexcept = delete;
+          ~wavetable();
+
+  static  wavetable* make(const fptype*, int) noexcept;
+  static  wavetable* make_sine() noexcept;
+
+          wavetable* acquire() noexcept;
+          void    release() noexcept;
+
+          const fptype* get_level(double) const noexcept;
+          int     get_level_count() const noexcept;
+          int     get_size() const noexcept;
+
+          wavetable& operator=(const wavetable&) noexcept = delete;
+          wavetable& operator=(wavetable&&) noexcept = delete;
+};
+
+/*namespace dsp*/ }
+#endif